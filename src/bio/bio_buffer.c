@@ -139,6 +139,47 @@ chk_type2str(int chk_type)
 	}
 }
 
+static inline char *
+dev_type2str(enum smd_dev_type st)
+{
+	switch (st) {
+	case SMD_DEV_TYPE_DATA:
+		return "data";
+	case SMD_DEV_TYPE_META:
+		return "meta";
+	case SMD_DEV_TYPE_WAL:
+		return "wal";
+	default:
+		return "unknown";
+	}
+}
+
+/* Latency histogram buckets: [0, 32us), [32us, 96us), ... doubling width */
+#define IO_LAT_BUCKETS		12
+#define IO_LAT_BUCKET_WIDTH	32
+
+static void
+io_lat_metric_init(struct d_tm_node_t **node, const char *op, enum smd_dev_type st, int tgt_id)
+{
+	char	path[D_TM_MAX_NAME_LEN];
+	char	desc[40];
+	int	rc;
+
+	snprintf(desc, sizeof(desc), "NVMe %s latency (%s)", op, dev_type2str(st));
+	snprintf(path, sizeof(path), "nvme_io/%s_lat_%s/tgt_%d", op, dev_type2str(st), tgt_id);
+	rc = d_tm_add_metric(node, D_TM_STATS_GAUGE, desc, "us", "%s", path);
+	if (rc) {
+		D_WARN("Failed to create %s_lat_%s telemetry: "DF_RC"\n", op, dev_type2str(st),
+		       DP_RC(rc));
+		return;
+	}
+
+	rc = d_tm_init_histogram(*node, path, IO_LAT_BUCKETS, IO_LAT_BUCKET_WIDTH, 2);
+	if (rc)
+		D_WARN("Failed to create %s_lat_%s histogram: "DF_RC"\n", op, dev_type2str(st),
+		       DP_RC(rc));
+}
+
 static void
 dma_metrics_init(struct bio_dma_buffer *bdb, int tgt_id)
 {
@@ -185,6 +226,28 @@ dma_metrics_init(struct bio_dma_buffer *bdb, int tgt_id)
 	if (rc)
 		D_WARN("Failed to create grab_retries telemetry: "DF_RC"\n", DP_RC(rc));
 
+	rc = d_tm_add_metric(&stats->bds_wait_time, D_TM_STATS_GAUGE, "Wait buffer time", "us",
+			     "dmabuff/wait_time/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create wait_time telemetry: "DF_RC"\n", DP_RC(rc));
+
+	if (bio_io_stat_sample == 0)
+		return;
+
+	for (i = SMD_DEV_TYPE_DATA; i < SMD_DEV_TYPE_MAX; i++) {
+		if (!bio_nvme_configured(i))
+			continue;
+
+		io_lat_metric_init(&stats->bds_read_lat[i], "read", i, tgt_id);
+		io_lat_metric_init(&stats->bds_write_lat[i], "write", i, tgt_id);
+
+		snprintf(desc, sizeof(desc), "NVMe queue depth (%s)", dev_type2str(i));
+		rc = d_tm_add_metric(&stats->bds_queue_depth[i], D_TM_STATS_GAUGE, desc, "req",
+				     "nvme_io/queue_depth_%s/tgt_%d", dev_type2str(i), tgt_id);
+		if (rc)
+			D_WARN("Failed to create queue_depth_%s telemetry: "DF_RC"\n",
+			       dev_type2str(i), DP_RC(rc));
+	}
 }
 
 struct bio_dma_buffer *
@@ -1109,6 +1172,26 @@ dma_drop_iod(struct bio_dma_buffer *bdb)
 	ABT_mutex_unlock(bdb->bdb_mutex);
 }
 
+/* Account the latency of sampled NVMe I/O, called on DMA transfer completion */
+static inline void
+iod_dma_lat(struct bio_desc *biod)
+{
+	struct bio_dma_stats	*stats;
+	struct d_tm_node_t	*lat;
+	enum smd_dev_type	 st;
+
+	if (biod->bd_dma_start == 0)
+		return;
+
+	stats = &iod_dma_buf(biod)->bdb_stats;
+	st = biod->bd_ctxt->bic_dev_type;
+	lat = biod->bd_type == BIO_IOD_TYPE_UPDATE ? stats->bds_write_lat[st] :
+						     stats->bds_read_lat[st];
+	if (lat)
+		d_tm_set_gauge(lat, daos_getutime() - biod->bd_dma_start);
+	biod->bd_dma_start = 0;
+}
+
 static void
 rw_completion(void *cb_arg, int err)
 {
@@ -1157,6 +1240,7 @@ rw_completion(void *cb_arg, int err)
 
 done:
 	if (biod->bd_inflights == 0) {
+		iod_dma_lat(biod);
 		iod_dma_completion(biod, err);
 		if (biod->bd_async_post && biod->bd_buffer_prep) {
 			iod_release_buffer(biod);
@@ -1262,6 +1346,14 @@ nvme_rw(struct bio_desc *biod, struct bio_rsrvd_region *rg)
 	D_ASSERT(pg_cnt > pg_idx);
 	pg_cnt -= pg_idx;
 
+	if (biod->bd_dma_start != 0 && !biod->bd_dma_issued) {
+		struct d_tm_node_t *qd;
+
+		qd = iod_dma_buf(biod)->bdb_stats.bds_queue_depth[biod->bd_ctxt->bic_dev_type];
+		if (qd)
+			d_tm_set_gauge(qd, bxb->bxb_blob_rw);
+	}
+
 	while (pg_cnt > 0) {
 
 		drain_inflight_ios(xs_ctxt, bxb);
@@ -1310,6 +1402,11 @@ dma_rw(struct bio_desc *biod)
 	D_ASSERT(biod->bd_type < BIO_IOD_TYPE_GETBUF);
 	D_DEBUG(DB_IO, "DMA start, type:%d\n", biod->bd_type);
 
+	biod->bd_dma_start = 0;
+	if (bio_io_stat_sample != 0 &&
+	    (iod_dma_buf(biod)->bdb_io_seq++ % bio_io_stat_sample) == 0)
+		biod->bd_dma_start = daos_getutime();
+
 	for (i = 0; i < rsrvd_dma->brd_rg_cnt; i++) {
 		rg = &rsrvd_dma->brd_regions[i];
 
@@ -1331,6 +1428,12 @@ dma_rw(struct bio_desc *biod)
 	D_ASSERT(biod->bd_inflights > 0);
 	biod->bd_inflights -= 1;
 
+	/* No NVMe I/O issued, or all of them completed already */
+	if (!biod->bd_dma_issued)
+		biod->bd_dma_start = 0;
+	else if (biod->bd_inflights == 0)
+		iod_dma_lat(biod);
+
 	//Yuanguo: block等待完成；
 	//   - BIO_IOD_TYPE_FETCH : bd_async_post一定为false;
 	//   - BIO_IOD_TYPE_UPDATE: bd_async_post可能为true;
@@ -1461,6 +1564,7 @@ static int
 iod_map_iovs(struct bio_desc *biod, void *arg)
 {
 	struct bio_dma_buffer	*bdb;
+	uint64_t		 wait_start = 0;
 	int			 rc, retry_cnt = 0;
 
 	/* NVMe context isn't allocated */
@@ -1469,6 +1573,8 @@ iod_map_iovs(struct bio_desc *biod, void *arg)
 	else
 		bdb = iod_dma_buf(biod);
 
+	if (bdb != NULL && bdb->bdb_queued_iods != 0 && !biod->bd_non_blocking)
+		wait_start = daos_getutime();
 	iod_fifo_in(biod, bdb);
 retry:
 	rc = iterate_biov(biod, arg ? bulk_map_one : dma_map_one, arg);
@@ -1502,6 +1608,8 @@ retry:
 		retry_cnt++;
 		D_DEBUG(DB_IO, "IOD %p waits for active IODs. %d\n", biod, retry_cnt);
 
+		if (wait_start == 0)
+			wait_start = daos_getutime();
 		iod_fifo_wait(biod, bdb);
 
 		D_DEBUG(DB_IO, "IOD %p finished waiting. %d\n", biod, retry_cnt);
@@ -1514,6 +1622,8 @@ retry:
 		d_tm_set_gauge(bdb->bdb_stats.bds_grab_retries, retry_cnt);
 out:
 	iod_fifo_out(biod, bdb);
+	if (wait_start != 0 && bdb->bdb_stats.bds_wait_time)
+		d_tm_set_gauge(bdb->bdb_stats.bds_wait_time, daos_getutime() - wait_start);
 	return rc;
 }
 
@@ -614,6 +614,7 @@ __bio_ioctxt_open(struct bio_io_context **pctxt, struct bio_xs_context *xs_ctxt,
 	}
 
 	ctxt->bic_xs_blobstore = bxb;
+	ctxt->bic_dev_type = st;
 	rc = bio_blob_open(ctxt, false, flags, st, open_blobid);
 	if (rc) {
 		D_FREE(ctxt);
@@ -110,6 +110,11 @@ struct bio_dma_stats {
 	struct d_tm_node_t	*bds_queued_iods;
 	struct d_tm_node_t	*bds_grab_errs;
 	struct d_tm_node_t	*bds_grab_retries;
+	struct d_tm_node_t	*bds_wait_time;
+	/* Sampled NVMe I/O latency & queue depth, per blob type */
+	struct d_tm_node_t	*bds_read_lat[SMD_DEV_TYPE_MAX];
+	struct d_tm_node_t	*bds_write_lat[SMD_DEV_TYPE_MAX];
+	struct d_tm_node_t	*bds_queue_depth[SMD_DEV_TYPE_MAX];
 };
 
 /*
@@ -130,6 +135,8 @@ struct bio_dma_buffer {
 	struct bio_bulk_cache	 bdb_bulk_cache;
 	struct bio_dma_stats	 bdb_stats;
 	uint64_t		 bdb_dump_ts;
+	/* Sequence number for sampling NVMe I/O statistics */
+	uint64_t		 bdb_io_seq;
 };
 
 #define BIO_PROTO_NVME_STATS_LIST					\
@@ -413,6 +420,7 @@ struct bio_io_context {
 	struct bio_xs_context	*bic_xs_ctxt;
 	uint32_t		 bic_inflight_dmas;
 	uint32_t		 bic_io_unit;
+	enum smd_dev_type	 bic_dev_type;
 	uuid_t			 bic_pool_id;
 	unsigned int		 bic_opening:1,
 				 bic_closing:1,
@@ -469,6 +477,8 @@ struct bio_desc {
 	unsigned int		 bd_type;
 	/* Total bytes landed to data blob */
 	unsigned int		 bd_nvme_bytes;
+	/* Start time (us) of sampled NVMe I/O, 0 if not sampled */
+	uint64_t		 bd_dma_start;
 	/* Flags */
 	unsigned int		 bd_buffer_prep:1,
 				 bd_dma_issued:1,
@@ -565,6 +575,7 @@ extern unsigned int	bio_chk_cnt_max;
 extern unsigned int	bio_numa_node;
 extern unsigned int	bio_spdk_max_unmap_cnt;
 extern unsigned int	bio_max_async_sz;
+extern unsigned int	bio_io_stat_sample;
 
 int xs_poll_completion(struct bio_xs_context *ctxt, unsigned int *inflights,
 		       uint64_t timeout);
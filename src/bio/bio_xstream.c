@@ -62,6 +62,8 @@ unsigned int bio_spdk_subsys_timeout = 25000;	/* ms */
 /* How many blob unmap calls can be called in a row */
 unsigned int bio_spdk_max_unmap_cnt = 32;
 unsigned int bio_max_async_sz = (1UL << 15) /* 32k */;
+/* Sample 1 of every N NVMe I/Os for latency statistics, 0 to disable */
+unsigned int bio_io_stat_sample = 64;
 
 struct bio_nvme_data {
 	ABT_mutex		 bd_mutex;
@@ -304,6 +306,9 @@ bio_nvme_init(const char *nvme_conf, int numa_node, unsigned int mem_size,
 	d_getenv_uint("DAOS_MAX_ASYNC_SZ", &bio_max_async_sz);
 	D_INFO("Max async data size is set to %u bytes\n", bio_max_async_sz);
 
+	d_getenv_uint("DAOS_NVME_IO_STAT_SAMPLE", &bio_io_stat_sample);
+	D_INFO("NVMe I/O statistics sample interval is %u\n", bio_io_stat_sample);
+
     //Yuanguo: mem_size就是当前numa node分配的hugepage内存；一个真实的例子：
     //  # cat /sys/devices/system/node/node0/hugepages/hugepages-2048kB/nr_hugepages
     //  9730
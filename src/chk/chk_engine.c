@@ -27,6 +27,9 @@
 #define DF_ENGINE	"Check engine (gen: "DF_X64")"
 #define DP_ENGINE(ins)	(ins)->ci_bk.cb_gen
 
+/* The max count of orphan containers to be reported and repaired concurrently. */
+#define CHK_CONT_ORPHAN_INFLIGHT	32
+
 static struct chk_instance	*chk_engine;
 
 struct chk_query_pool_args {
@@ -77,6 +80,14 @@ struct chk_pool_mbs_args {
 	struct chk_pool_rec		*cpma_cpr;
 };
 
+struct chk_cont_orphan_args {
+	struct chk_pool_rec		*ccoa_cpr;
+	struct chk_cont_rec		*ccoa_ccr;
+	struct cont_svc			*ccoa_svc;
+	ABT_thread			 ccoa_thread;
+	int				 ccoa_rc;
+};
+
 static int chk_engine_report(struct chk_report_unit *cru, uint64_t *seq, int *decision);
 
 static int
@@ -1556,6 +1567,27 @@ out:
 	return rc;
 }
 
+static void
+chk_engine_cont_orphan_ult(void *args)
+{
+	struct chk_cont_orphan_args	*ccoa = args;
+
+	ccoa->ccoa_rc = chk_engine_cont_orphan(ccoa->ccoa_cpr, ccoa->ccoa_ccr, ccoa->ccoa_svc);
+}
+
+/* Wait for the orphan container ULT in the slot (if any) to exit, return its result. */
+static int
+chk_engine_cont_orphan_join(struct chk_cont_orphan_args *ccoa)
+{
+	if (ccoa->ccoa_thread == ABT_THREAD_NULL)
+		return 0;
+
+	ABT_thread_free(&ccoa->ccoa_thread);
+	ccoa->ccoa_thread = ABT_THREAD_NULL;
+
+	return ccoa->ccoa_rc;
+}
+
 static int
 chk_engine_cont_cleanup(struct chk_pool_rec *cpr, struct ds_pool_svc *ds_svc,
 			struct chk_cont_list_aggregator *aggregator)
@@ -1564,7 +1596,12 @@ chk_engine_cont_cleanup(struct chk_pool_rec *cpr, struct ds_pool_svc *ds_svc,
 	struct cont_svc			*svc;
 	struct chk_cont_rec		*ccr;
 	struct chk_cont_label_cb_args	 cclca = { 0 };
+	struct chk_cont_orphan_args	*ccoas = NULL;
+	struct chk_cont_orphan_args	*ccoa;
+	uint32_t			 orphan_nr = 0;
 	int				 rc = 0;
+	int				 rc1;
+	int				 i;
 	bool				 failout;
 
 	if (ins->ci_prop.cp_flags & CHK__CHECK_FLAG__CF_FAILOUT)
@@ -1573,6 +1610,19 @@ chk_engine_cont_cleanup(struct chk_pool_rec *cpr, struct ds_pool_svc *ds_svc,
 		failout = false;
 	svc = ds_pool_ps2cs(ds_svc);
 
+	D_ALLOC_ARRAY(ccoas, CHK_CONT_ORPHAN_INFLIGHT);
+	if (ccoas == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	for (i = 0; i < CHK_CONT_ORPHAN_INFLIGHT; i++)
+		ccoas[i].ccoa_thread = ABT_THREAD_NULL;
+
+	/*
+	 * Each orphan container costs a report RPC to the leader, may wait for the admin's
+	 * decision, and its repair broadcasts the destroy to all engines. Handle the orphans
+	 * via a bounded count of concurrent ULTs, so that these round trips overlap instead
+	 * of being paid one container after another.
+	 */
 	d_list_for_each_entry(ccr, &aggregator->ccla_list, ccr_link) {
 		rc = ds_cont_existence_check(svc, ccr->ccr_uuid, &ccr->ccr_label_prop);
 		if (rc == 0)
@@ -1586,17 +1636,41 @@ chk_engine_cont_cleanup(struct chk_pool_rec *cpr, struct ds_pool_svc *ds_svc,
 				 DP_UUID(ccr->ccr_uuid), DP_RC(rc));
 
 			if (failout)
-				goto out;
+				goto join;
 
 			ccr->ccr_skip = 1;
 			continue;
 		}
 
-		rc = chk_engine_cont_orphan(cpr, ccr, svc);
+		ccoa = &ccoas[orphan_nr++ % CHK_CONT_ORPHAN_INFLIGHT];
+		rc = chk_engine_cont_orphan_join(ccoa);
 		if (rc != 0)
-			goto out;
+			goto join;
+
+		ccoa->ccoa_cpr = cpr;
+		ccoa->ccoa_ccr = ccr;
+		ccoa->ccoa_svc = svc;
+		ccoa->ccoa_rc = 0;
+		rc = dss_ult_create(chk_engine_cont_orphan_ult, ccoa, DSS_XS_SELF, 0,
+				    DSS_DEEP_STACK_SZ, &ccoa->ccoa_thread);
+		if (rc != 0) {
+			D_ERROR(DF_ENGINE" on rank %u failed to create ULT for orphan container "
+				DF_UUIDF"/"DF_UUIDF": "DF_RC"\n", DP_ENGINE(ins), dss_self_rank(),
+				DP_UUID(cpr->cpr_uuid), DP_UUID(ccr->ccr_uuid), DP_RC(rc));
+			ccoa->ccoa_thread = ABT_THREAD_NULL;
+			goto join;
+		}
 	}
 
+join:
+	for (i = 0; i < CHK_CONT_ORPHAN_INFLIGHT; i++) {
+		rc1 = chk_engine_cont_orphan_join(&ccoas[i]);
+		if (rc == 0)
+			rc = rc1;
+	}
+	if (rc != 0)
+		goto out;
+
 	cclca.cclca_aggregator = aggregator;
 	cclca.cclca_svc = svc;
 	cclca.cclca_cpr = cpr;
@@ -1613,6 +1687,7 @@ chk_engine_cont_cleanup(struct chk_pool_rec *cpr, struct ds_pool_svc *ds_svc,
 	}
 
 out:
+	D_FREE(ccoas);
 	return rc;
 }
 
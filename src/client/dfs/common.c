@@ -324,28 +324,33 @@ punch_entry:
 	return daos_der2errno(rc);
 }
 
-int
-insert_entry(dfs_layout_ver_t ver, daos_handle_t oh, daos_handle_t th, const char *name, size_t len,
-	     uint64_t flags, struct dfs_entry *entry)
+/** Descriptors of the update inserting one entry, must stay valid until the update completes */
+struct insert_args {
+	daos_key_t  dkey;
+	daos_iod_t  iods[2];
+	d_sg_list_t sgls[2];
+	d_iov_t     sg_iovs[INODE_AKEYS];
+	d_iov_t     sym_iov;
+	daos_recx_t recx;
+	uint32_t    nr_iods;
+};
+
+static void
+insert_args_set(struct insert_args *args, const char *name, size_t len, struct dfs_entry *entry)
 {
-	d_sg_list_t  sgls[2];
-	d_iov_t      sg_iovs[INODE_AKEYS];
-	d_iov_t      sym_iov;
-	daos_iod_t   iods[2];
-	daos_recx_t  recx;
-	daos_key_t   dkey;
+	d_sg_list_t *sgls    = args->sgls;
+	d_iov_t     *sg_iovs = args->sg_iovs;
+	daos_iod_t  *iods    = args->iods;
 	unsigned int i;
-	unsigned int nr_iods;
-	int          rc;
 
-	d_iov_set(&dkey, (void *)name, len);
+	d_iov_set(&args->dkey, (void *)name, len);
 	d_iov_set(&iods[0].iod_name, INODE_AKEY_NAME, sizeof(INODE_AKEY_NAME) - 1);
-	iods[0].iod_nr    = 1;
-	recx.rx_idx       = 0;
-	recx.rx_nr        = END_IDX;
-	iods[0].iod_recxs = &recx;
-	iods[0].iod_type  = DAOS_IOD_ARRAY;
-	iods[0].iod_size  = 1;
+	iods[0].iod_nr     = 1;
+	args->recx.rx_idx  = 0;
+	args->recx.rx_nr   = END_IDX;
+	iods[0].iod_recxs  = &args->recx;
+	iods[0].iod_type   = DAOS_IOD_ARRAY;
+	iods[0].iod_size   = 1;
 
 	i = 0;
 	d_iov_set(&sg_iovs[i++], &entry->mode, sizeof(mode_t));
@@ -364,26 +369,35 @@ insert_entry(dfs_layout_ver_t ver, daos_handle_t oh, daos_handle_t th, const cha
 
 	/** add the symlink as a separate akey */
 	if (S_ISLNK(entry->mode)) {
-		nr_iods = 2;
+		args->nr_iods = 2;
 		d_iov_set(&iods[1].iod_name, SLINK_AKEY_NAME, sizeof(SLINK_AKEY_NAME) - 1);
 		iods[1].iod_nr    = 1;
 		iods[1].iod_recxs = NULL;
 		iods[1].iod_type  = DAOS_IOD_SINGLE;
 		iods[1].iod_size  = entry->value_len;
 
-		d_iov_set(&sym_iov, entry->value, entry->value_len);
+		d_iov_set(&args->sym_iov, entry->value, entry->value_len);
 		sgls[1].sg_nr     = 1;
 		sgls[1].sg_nr_out = 0;
-		sgls[1].sg_iovs   = &sym_iov;
+		sgls[1].sg_iovs   = &args->sym_iov;
 	} else {
-		nr_iods = 1;
+		args->nr_iods = 1;
 	}
 
 	sgls[0].sg_nr     = i;
 	sgls[0].sg_nr_out = 0;
 	sgls[0].sg_iovs   = sg_iovs;
+}
 
-	rc = daos_obj_update(oh, th, flags, &dkey, nr_iods, iods, sgls, NULL);
+int
+insert_entry(dfs_layout_ver_t ver, daos_handle_t oh, daos_handle_t th, const char *name, size_t len,
+	     uint64_t flags, struct dfs_entry *entry)
+{
+	struct insert_args args;
+	int                rc;
+
+	insert_args_set(&args, name, len, entry);
+	rc = daos_obj_update(oh, th, flags, &args.dkey, args.nr_iods, args.iods, args.sgls, NULL);
 	if (rc) {
 		/** don't log error if conditional failed */
 		if (rc != -DER_EXIST && rc != -DER_NO_PERM)
@@ -393,6 +407,181 @@ insert_entry(dfs_layout_ver_t ver, daos_handle_t oh, daos_handle_t th, const cha
 	return 0;
 }
 
+/** Max number of events reaped by one poll of inflight_eq_wait() */
+#define INFLIGHT_POLL_NR 128
+
+int
+inflight_eq_create(struct inflight_eq *ieq)
+{
+	int rc;
+
+	ieq->aborted = false;
+	rc           = daos_eq_create(&ieq->eq);
+	if (rc) {
+		D_ERROR("daos_eq_create() failed: " DF_RC "\n", DP_RC(rc));
+		return daos_der2errno(rc);
+	}
+	return 0;
+}
+
+int
+inflight_eq_wait(struct inflight_eq *ieq, uint32_t *inflight, uint32_t max, inflight_eq_cb_t cb,
+		 void *arg)
+{
+	daos_event_t *evs[INFLIGHT_POLL_NR];
+	int           rc;
+	int           rc2;
+	int           i;
+
+	if (ieq->aborted) {
+		*inflight = 0;
+		return ECANCELED;
+	}
+
+	while (*inflight > max) {
+		rc = daos_eq_poll(ieq->eq, 1, DAOS_EQ_WAIT, INFLIGHT_POLL_NR, evs);
+		if (rc >= 0) {
+			for (i = 0; i < rc; i++)
+				cb(arg, evs[i]);
+			continue;
+		}
+
+		D_ERROR("daos_eq_poll() failed: " DF_RC "\n", DP_RC(rc));
+		/** flush and abort everything in flight before the caller releases any memory */
+		rc2 = daos_eq_destroy(ieq->eq, DAOS_EQ_DESTROY_FORCE);
+		if (rc2) {
+			D_ERROR("Failed to abort %u operations in flight, leaking them: " DF_RC "\n",
+				*inflight, DP_RC(rc2));
+			return daos_der2errno(rc);
+		}
+		ieq->aborted = true;
+		*inflight    = 0;
+		return daos_der2errno(rc);
+	}
+	return 0;
+}
+
+int
+inflight_eq_destroy(struct inflight_eq *ieq)
+{
+	int rc;
+
+	if (ieq->aborted)
+		return 0;
+
+	rc = daos_eq_destroy(ieq->eq, 0);
+	if (rc) {
+		D_ERROR("daos_eq_destroy() failed: " DF_RC "\n", DP_RC(rc));
+		return daos_der2errno(rc);
+	}
+	return 0;
+}
+
+/** Max number of inserts in flight for insert_entries() */
+#define INSERT_INFLIGHT 128
+
+struct insert_slot {
+	daos_event_t       ev;
+	struct insert_args args;
+	uint32_t           idx;
+};
+
+struct insert_ctx {
+	const char         **names;
+	int                 *rcs;
+	struct insert_slot **free_slots;
+	uint32_t             nr_free;
+	uint32_t             inflight;
+};
+
+static void
+insert_slot_done(void *arg, daos_event_t *ev)
+{
+	struct insert_ctx  *ctx  = arg;
+	struct insert_slot *slot = container_of(ev, struct insert_slot, ev);
+	int                 rc   = ev->ev_error;
+
+	if (rc && rc != -DER_EXIST && rc != -DER_NO_PERM)
+		D_ERROR("Failed to insert entry '%s', " DF_RC "\n", ctx->names[slot->idx],
+			DP_RC(rc));
+	ctx->rcs[slot->idx]             = daos_der2errno(rc);
+	ctx->free_slots[ctx->nr_free++] = slot;
+	ctx->inflight--;
+}
+
+int
+insert_entries(daos_handle_t oh, uint32_t nr, const char **names, size_t *lens,
+	       struct dfs_entry *entries, int *rcs)
+{
+	struct insert_ctx   ctx = {0};
+	struct inflight_eq  ieq;
+	struct insert_slot *slots;
+	struct insert_slot *slot;
+	uint32_t            nr_slots = min(nr, INSERT_INFLIGHT);
+	uint32_t            nr_init  = 0;
+	uint32_t            i;
+	int                 rc;
+
+	if (nr == 0)
+		return 0;
+
+	rc = inflight_eq_create(&ieq);
+	if (rc)
+		return rc;
+
+	ctx.names = names;
+	ctx.rcs   = rcs;
+	D_ALLOC_ARRAY(slots, nr_slots);
+	if (slots == NULL)
+		D_GOTO(out_eq, rc = ENOMEM);
+	D_ALLOC_ARRAY(ctx.free_slots, nr_slots);
+	if (ctx.free_slots == NULL)
+		D_GOTO(out_slots, rc = ENOMEM);
+
+	for (nr_init = 0; nr_init < nr_slots; nr_init++) {
+		rc = daos_event_init(&slots[nr_init].ev, ieq.eq, NULL);
+		if (rc)
+			D_GOTO(out_slots, rc = daos_der2errno(rc));
+		ctx.free_slots[ctx.nr_free++] = &slots[nr_init];
+	}
+
+	for (i = 0; i < nr; i++) {
+		/** entry rejected by the caller already */
+		if (rcs[i] != 0)
+			continue;
+
+		/** wait for a free slot */
+		rc = inflight_eq_wait(&ieq, &ctx.inflight, nr_slots - 1, insert_slot_done, &ctx);
+		if (rc)
+			D_GOTO(out_slots, rc);
+
+		slot      = ctx.free_slots[--ctx.nr_free];
+		slot->idx = i;
+		insert_args_set(&slot->args, names[i], lens[i], &entries[i]);
+		rc = daos_obj_update(oh, DAOS_TX_NONE, DAOS_COND_DKEY_INSERT, &slot->args.dkey,
+				     slot->args.nr_iods, slot->args.iods, slot->args.sgls, &slot->ev);
+		if (rc) {
+			rcs[i]                        = daos_der2errno(rc);
+			ctx.free_slots[ctx.nr_free++] = slot;
+			continue;
+		}
+		ctx.inflight++;
+	}
+	rc = inflight_eq_wait(&ieq, &ctx.inflight, 0, insert_slot_done, &ctx);
+
+out_slots:
+	/** inserts that could not be aborted still reference the slots */
+	if (ctx.inflight > 0)
+		return rc;
+	for (i = 0; i < nr_init && !ieq.aborted; i++)
+		daos_event_fini(&slots[i].ev);
+	D_FREE(ctx.free_slots);
+	D_FREE(slots);
+out_eq:
+	inflight_eq_destroy(&ieq);
+	return rc;
+}
+
 int
 get_num_entries(daos_handle_t oh, daos_handle_t th, uint32_t *nr, bool check_empty)
 {
@@ -330,168 +330,470 @@ struct dfs_oit_args {
 	uint64_t      num_scanned;
 };
 
+struct dfs_scan_args {
+	time_t   start_time;
+	uint64_t max_depth;
+	uint64_t num_files;
+	uint64_t num_dirs;
+	uint64_t num_symlinks;
+	uint64_t total_bytes;
+	uint64_t largest_file;
+	uint64_t largest_dir;
+	uint64_t num_scanned;
+};
+
+/** Print the progress of the checker or scanner every DFS_ELAPSED_TIME seconds */
+static void
+print_progress(const char *who, const char *what, uint64_t nr, time_t start_time,
+	       time_t *print_time)
+{
+	struct timespec now;
+	uint64_t        runtime;
+
+	if (clock_gettime(CLOCK_REALTIME, &now))
+		return;
+	if (now.tv_sec - *print_time < DFS_ELAPSED_TIME)
+		return;
+
+	runtime = now.tv_sec - start_time;
+	D_PRINT("%s: " DF_U64 " %s (runtime: " DF_U64 " sec, " DF_U64 " per sec)\n", who, nr, what,
+		runtime, nr / max(runtime, 1));
+	*print_time = now.tv_sec;
+}
+
+enum ns_stage {
+	NS_FETCH,
+	NS_FETCHED,
+	NS_MARK,
+	NS_SIZE,
+	NS_DONE,
+};
+
+struct ns_batch;
+
+/** One namespace entry visited by the checker or the scanner */
+struct ns_op {
+	daos_event_t     ev;
+	struct ns_batch *batch;
+	enum ns_stage    stage;
+	mode_t           mode;
+	daos_obj_id_t    oid;
+	daos_size_t      chunk_size;
+	daos_size_t      size;
+	daos_handle_t    aoh;
+	daos_key_t       dkey;
+	daos_iod_t       iod;
+	daos_recx_t      recxs[2];
+	d_sg_list_t      sgl;
+	d_iov_t          sg_iovs[3];
+};
+
+/** One enumeration batch of a directory, all entries of a batch are kept in flight */
+struct ns_batch {
+	daos_handle_t   oh;
+	uint32_t        inflight;
+	int             rc;
+	struct ns_op    ops[DFS_ITER_NR];
+	daos_key_desc_t kds[DFS_ITER_NR];
+	char            enum_buf[DFS_ITER_ENTRY_BUF];
+};
+
+/**
+ * Namespace walk of the checker (marking every reachable OID in the OIT) or of the scanner
+ * (collecting usage). Exactly one of oit_args and scan_args is set.
+ */
+struct ns_walk {
+	dfs_t                *dfs;
+	struct inflight_eq    ieq;
+	struct dfs_oit_args  *oit_args;
+	struct dfs_scan_args *scan_args;
+	const char           *who;
+	/** progress label of num_scanned */
+	const char           *what;
+	bool                  verify;
+	uint64_t              depth;
+	uint64_t              num_scanned;
+	time_t                start_time;
+	time_t                print_time;
+};
+
+static void
+ns_op_fail(struct ns_op *op, int rc)
+{
+	if (op->batch->rc == 0)
+		op->batch->rc = rc;
+	op->stage = NS_DONE;
+}
+
+/** Fetch the mode, OID and chunk size of the entry of \a op */
+static void
+ns_op_fetch(struct ns_op *op, char *name, size_t len)
+{
+	int rc;
+
+	d_iov_set(&op->dkey, name, len);
+	d_iov_set(&op->iod.iod_name, INODE_AKEY_NAME, sizeof(INODE_AKEY_NAME) - 1);
+	op->recxs[0].rx_idx = MODE_IDX;
+	op->recxs[0].rx_nr  = MTIME_IDX;
+	op->recxs[1].rx_idx = CSIZE_IDX;
+	op->recxs[1].rx_nr  = sizeof(daos_size_t);
+	op->iod.iod_nr      = 2;
+	op->iod.iod_recxs   = op->recxs;
+	op->iod.iod_type    = DAOS_IOD_ARRAY;
+	op->iod.iod_size    = 1;
+
+	op->mode = 0;
+	d_iov_set(&op->sg_iovs[0], &op->mode, sizeof(mode_t));
+	d_iov_set(&op->sg_iovs[1], &op->oid, sizeof(daos_obj_id_t));
+	d_iov_set(&op->sg_iovs[2], &op->chunk_size, sizeof(daos_size_t));
+	op->sgl.sg_nr     = 3;
+	op->sgl.sg_nr_out = 0;
+	op->sgl.sg_iovs   = op->sg_iovs;
+
+	op->stage = NS_FETCH;
+	rc = daos_obj_fetch(op->batch->oh, DAOS_TX_NONE, DAOS_COND_DKEY_FETCH, &op->dkey, 1,
+			    &op->iod, &op->sgl, NULL, &op->ev);
+	if (rc) {
+		D_ERROR("daos_obj_fetch() failed " DF_RC "\n", DP_RC(rc));
+		ns_op_fail(op, daos_der2errno(rc));
+	} else {
+		op->batch->inflight++;
+	}
+}
+
+/** Verify the object of \a op if requested and mark it in the OIT */
+static void
+ns_op_mark(struct ns_walk *walk, struct ns_op *op)
+{
+	struct dfs_oit_args *oit_args  = walk->oit_args;
+	bool                 mark_data = true;
+	d_iov_t              marker;
+	int                  rc;
+
+	if (walk->verify) {
+		rc = daos_obj_verify(walk->dfs->coh, op->oid, oit_args->snap_epoch);
+		if (rc == -DER_NOSYS) {
+			oit_args->skipped++;
+		} else if (rc == -DER_MISMATCH) {
+			oit_args->failed++;
+			if (oit_args->flags & DFS_CHECK_PRINT)
+				D_PRINT("" DF_OID " failed data consistency check!\n",
+					DP_OID(op->oid));
+		} else if (rc) {
+			D_ERROR("daos_obj_verify() failed " DF_RC "\n", DP_RC(rc));
+			ns_op_fail(op, daos_der2errno(rc));
+			return;
+		}
+	}
+
+	/** the marker is copied before the operation is scheduled */
+	d_iov_set(&marker, &mark_data, sizeof(mark_data));
+	op->stage = NS_MARK;
+	rc = daos_oit_mark(oit_args->oit, op->oid, &marker, &op->ev);
+	if (rc) {
+		D_ERROR("Failed to mark OID in OIT: " DF_RC "\n", DP_RC(rc));
+		ns_op_fail(op, daos_der2errno(rc));
+	} else {
+		op->batch->inflight++;
+	}
+}
+
+/** Query the size of the file of \a op */
+static void
+ns_op_size(struct ns_walk *walk, struct ns_op *op)
+{
+	dfs_t *dfs = walk->dfs;
+	int    rc;
+
+	rc = daos_array_open_with_attr(dfs->coh, op->oid, DAOS_TX_NONE, DAOS_OO_RO, 1,
+				       op->chunk_size ? op->chunk_size : dfs->attr.da_chunk_size,
+				       &op->aoh, NULL);
+	if (rc) {
+		D_ERROR("daos_array_open_with_attr() failed " DF_RC "\n", DP_RC(rc));
+		ns_op_fail(op, daos_der2errno(rc));
+		return;
+	}
+
+	op->stage = NS_SIZE;
+	rc = daos_array_get_size(op->aoh, DAOS_TX_NONE, &op->size, &op->ev);
+	if (rc) {
+		D_ERROR("daos_array_get_size() failed " DF_RC "\n", DP_RC(rc));
+		daos_array_close(op->aoh, NULL);
+		ns_op_fail(op, daos_der2errno(rc));
+	} else {
+		op->batch->inflight++;
+	}
+}
+
+/** Account for the fetched entry of \a op and start marking it or querying its size */
+static void
+ns_op_visit(struct ns_walk *walk, struct ns_op *op)
+{
+	struct dfs_scan_args *scan_args = walk->scan_args;
+
+	walk->num_scanned++;
+	print_progress(walk->who, walk->what, walk->num_scanned, walk->start_time,
+		       &walk->print_time);
+
+	if (walk->oit_args != NULL) {
+		ns_op_mark(walk, op);
+		return;
+	}
+
+	if (scan_args->max_depth < walk->depth)
+		scan_args->max_depth = walk->depth;
+	if (S_ISDIR(op->mode)) {
+		scan_args->num_dirs++;
+	} else if (S_ISLNK(op->mode)) {
+		scan_args->num_symlinks++;
+	} else {
+		scan_args->num_files++;
+		ns_op_size(walk, op);
+		return;
+	}
+	op->stage = NS_DONE;
+}
+
+/** Advance the op of \a ev to its next stage after its in-flight operation completed */
+static void
+ns_op_complete(void *arg, daos_event_t *ev)
+{
+	struct ns_walk       *walk      = arg;
+	struct ns_op         *op        = container_of(ev, struct ns_op, ev);
+	struct dfs_scan_args *scan_args = walk->scan_args;
+	int                   rc        = ev->ev_error;
+
+	op->batch->inflight--;
+
+	switch (op->stage) {
+	case NS_FETCH:
+		if (rc == -DER_NONEXIST || (rc == 0 && op->sgl.sg_nr_out == 0)) {
+			op->mode  = 0;
+			op->stage = NS_DONE;
+			break;
+		}
+		if (rc) {
+			D_ERROR("Failed to fetch entry " DF_RC "\n", DP_RC(rc));
+			ns_op_fail(op, daos_der2errno(rc));
+			break;
+		}
+		op->stage = NS_FETCHED;
+		break;
+	case NS_MARK:
+		/*
+		 * If the entry exists but the file or directory are empty, the corresponding oid
+		 * itself has not been written to, so it doesn't exist in the OIT.
+		 */
+		if (rc && rc != -DER_NONEXIST) {
+			D_ERROR("Failed to mark OID in OIT: " DF_RC "\n", DP_RC(rc));
+			ns_op_fail(op, daos_der2errno(rc));
+			break;
+		}
+		op->stage = NS_DONE;
+		break;
+	case NS_SIZE:
+		daos_array_close(op->aoh, NULL);
+		if (rc) {
+			D_ERROR("daos_array_get_size() failed " DF_RC "\n", DP_RC(rc));
+			ns_op_fail(op, daos_der2errno(rc));
+			break;
+		}
+		scan_args->total_bytes += op->size;
+		if (scan_args->largest_file < op->size)
+			scan_args->largest_file = op->size;
+		op->stage = NS_DONE;
+		break;
+	default:
+		D_ASSERTF(0, "unexpected stage %d\n", op->stage);
+	}
+}
+
+/** Wait until all operations of \a batch completed, returning the first error of the batch */
 static int
-fetch_mark_oids(daos_handle_t coh, daos_obj_id_t oid, daos_key_desc_t *kds, char *enum_buf,
-		struct dfs_oit_args *args)
+ns_batch_drain(struct ns_walk *walk, struct ns_batch *batch)
 {
-	daos_handle_t oh;
-	d_sg_list_t   sgl, entry_sgl;
-	d_iov_t       iov, sg_iov;
-	daos_recx_t   recx;
-	uint32_t      nr;
-	daos_iod_t    iod;
-	d_iov_t       marker;
-	bool          mark_data = true;
-	daos_anchor_t anchor    = {0};
-	int           rc, rc2;
+	int rc;
 
-	rc = daos_obj_open(coh, oid, DAOS_OO_RW, &oh, NULL);
+	rc = inflight_eq_wait(&walk->ieq, &batch->inflight, 0, ns_op_complete, walk);
+	return rc ? rc : batch->rc;
+}
+
+/**
+ * Visit all entries of the directory \a oid, a batch of entries at a time with all lookups, OIT
+ * marks or size queries of the batch in flight, and optionally descend into sub-directories.
+ */
+static int
+ns_walk_dir(struct ns_walk *walk, daos_obj_id_t oid, bool descend, uint64_t *nr_total)
+{
+	struct ns_batch *batch;
+	daos_anchor_t    anchor = {0};
+	d_iov_t          iov;
+	d_sg_list_t      sgl;
+	int              nr_ev = 0;
+	int              rc;
+	int              rc2;
+	int              i;
+
+	*nr_total = 0;
+
+	D_ALLOC_PTR(batch);
+	if (batch == NULL)
+		return ENOMEM;
+
+	rc = daos_obj_open(walk->dfs->coh, oid, DAOS_OO_RO, &batch->oh, NULL);
 	if (rc) {
 		D_ERROR("daos_obj_open() failed " DF_RC "\n", DP_RC(rc));
-		return daos_der2errno(rc);
+		D_GOTO(out_free, rc = daos_der2errno(rc));
+	}
+
+	for (nr_ev = 0; nr_ev < DFS_ITER_NR; nr_ev++) {
+		batch->ops[nr_ev].batch = batch;
+		rc = daos_event_init(&batch->ops[nr_ev].ev, walk->ieq.eq, NULL);
+		if (rc)
+			D_GOTO(out, rc = daos_der2errno(rc));
 	}
 
-	/** set sgl for enumeration */
 	sgl.sg_nr     = 1;
 	sgl.sg_nr_out = 0;
-	d_iov_set(&iov, enum_buf, DFS_ITER_ENTRY_BUF);
+	d_iov_set(&iov, batch->enum_buf, DFS_ITER_ENTRY_BUF);
 	sgl.sg_iovs = &iov;
 
-	/** set sgl for fetch */
-	entry_sgl.sg_nr     = 1;
-	entry_sgl.sg_nr_out = 0;
-	entry_sgl.sg_iovs   = &sg_iov;
-
-	d_iov_set(&iod.iod_name, INODE_AKEY_NAME, sizeof(INODE_AKEY_NAME) - 1);
-	recx.rx_idx   = OID_IDX;
-	recx.rx_nr    = sizeof(daos_obj_id_t);
-	iod.iod_nr    = 1;
-	iod.iod_recxs = &recx;
-	iod.iod_type  = DAOS_IOD_ARRAY;
-	iod.iod_size  = 1;
-
-	d_iov_set(&marker, &mark_data, sizeof(mark_data));
 	while (!daos_anchor_is_eof(&anchor)) {
-		uint32_t i;
+		uint32_t number = DFS_ITER_NR;
 		char    *ptr;
 
-		nr = DFS_ITER_NR;
-		rc = daos_obj_list_dkey(oh, DAOS_TX_NONE, &nr, kds, &sgl, &anchor, NULL);
+		rc = daos_obj_list_dkey(batch->oh, DAOS_TX_NONE, &number, batch->kds, &sgl,
+					&anchor, NULL);
 		if (rc) {
 			D_ERROR("daos_obj_list_dkey() failed " DF_RC "\n", DP_RC(rc));
-			D_GOTO(out_obj, rc = daos_der2errno(rc));
+			D_GOTO(out, rc = daos_der2errno(rc));
 		}
 
-		/** for every entry, fetch its oid and mark it in the oit table */
-		for (ptr = enum_buf, i = 0; i < nr; i++) {
-			daos_obj_id_t entry_oid;
-			daos_key_t    dkey;
+		if (number == 0)
+			continue;
+		*nr_total += number;
 
-			d_iov_set(&dkey, ptr, kds[i].kd_key_len);
-			d_iov_set(&sg_iov, &entry_oid, sizeof(daos_obj_id_t));
+		for (ptr = batch->enum_buf, i = 0; i < number; i++) {
+			ns_op_fetch(&batch->ops[i], ptr, batch->kds[i].kd_key_len);
+			ptr += batch->kds[i].kd_key_len;
+		}
+		rc = ns_batch_drain(walk, batch);
+		if (rc)
+			D_GOTO(out, rc);
 
-			rc = daos_obj_fetch(oh, DAOS_TX_NONE, DAOS_COND_DKEY_FETCH, &dkey, 1, &iod,
-					    &entry_sgl, NULL, NULL);
-			if (rc) {
-				D_ERROR("daos_obj_fetch() failed " DF_RC "\n", DP_RC(rc));
-				D_GOTO(out_obj, rc = daos_der2errno(rc));
-			}
+		for (i = 0; i < number; i++) {
+			if (batch->ops[i].stage == NS_FETCHED)
+				ns_op_visit(walk, &batch->ops[i]);
+		}
+		rc = ns_batch_drain(walk, batch);
+		if (rc)
+			D_GOTO(out, rc);
 
-			/** mark oid in the oit table */
-			rc = daos_oit_mark(args->oit, entry_oid, &marker, NULL);
-			if (rc && rc != -DER_NONEXIST) {
-				D_ERROR("daos_oit_mark() failed " DF_RC "\n", DP_RC(rc));
-				D_GOTO(out_obj, rc = daos_der2errno(rc));
-			}
-			rc = 0;
-			ptr += kds[i].kd_key_len;
+		if (!descend)
+			continue;
+
+		for (i = 0; i < number; i++) {
+			uint64_t nr_entries;
+
+			if (!S_ISDIR(batch->ops[i].mode))
+				continue;
+
+			walk->depth++;
+			rc = ns_walk_dir(walk, batch->ops[i].oid, true, &nr_entries);
+			walk->depth--;
+			if (rc)
+				D_GOTO(out, rc);
+			if (walk->scan_args && walk->scan_args->largest_dir < nr_entries)
+				walk->scan_args->largest_dir = nr_entries;
 		}
 	}
 
-out_obj:
-	rc2 = daos_obj_close(oh, NULL);
+out:
+	rc2 = ns_batch_drain(walk, batch);
 	if (rc == 0)
 		rc = rc2;
+	/** operations that could not be aborted still reference the batch */
+	if (batch->inflight > 0)
+		return rc;
+	for (i = 0; i < nr_ev && !walk->ieq.aborted; i++)
+		daos_event_fini(&batch->ops[i].ev);
+	daos_obj_close(batch->oh, NULL);
+out_free:
+	D_FREE(batch);
 	return rc;
 }
 
-static int
-oit_mark_cb(dfs_t *dfs, dfs_obj_t *parent, const char name[], void *args)
-{
-	struct dfs_oit_args *oit_args = (struct dfs_oit_args *)args;
-	dfs_obj_t           *obj;
-	daos_obj_id_t        oid;
-	d_iov_t              marker;
-	bool                 mark_data = true;
-	struct timespec      current_time;
-	int                  rc;
-
-	rc = clock_gettime(CLOCK_REALTIME, &current_time);
-	if (rc)
-		return errno;
-	oit_args->num_scanned++;
-	if (current_time.tv_sec - oit_args->print_time >= DFS_ELAPSED_TIME) {
-		D_PRINT("DFS checker: Scanned " DF_U64 " files/directories (runtime: " DF_U64
-			" sec)\n",
-			oit_args->num_scanned, current_time.tv_sec - oit_args->start_time);
-		oit_args->print_time = current_time.tv_sec;
-	}
+struct punch_op {
+	daos_event_t  ev;
+	daos_handle_t oh;
+};
 
-	/** open the entry name and get the oid */
-	rc = dfs_lookup_rel(dfs, parent, name, O_RDONLY | O_NOFOLLOW, &obj, NULL, NULL);
-	if (rc) {
-		D_ERROR("dfs_lookup_rel() of %s failed: %d\n", name, rc);
-		return rc;
-	}
+struct punch_ctx {
+	uint32_t inflight;
+	int      rc;
+};
 
-	rc = dfs_obj2id(obj, &oid);
-	if (rc)
-		D_GOTO(out_obj, rc);
+static void
+punch_op_done(void *arg, daos_event_t *ev)
+{
+	struct punch_ctx *ctx = arg;
+	struct punch_op  *op  = container_of(ev, struct punch_op, ev);
 
-	if (oit_args->flags & DFS_CHECK_VERIFY) {
-		rc = daos_obj_verify(dfs->coh, oid, oit_args->snap_epoch);
-		if (rc == -DER_NOSYS) {
-			oit_args->skipped++;
-		} else if (rc == -DER_MISMATCH) {
-			oit_args->failed++;
-			if (oit_args->flags & DFS_CHECK_PRINT)
-				D_PRINT("" DF_OID " failed data consistency check!\n", DP_OID(oid));
-		} else if (rc) {
-			D_ERROR("daos_obj_verify() failed " DF_RC "\n", DP_RC(rc));
-			D_GOTO(out_obj, rc = daos_der2errno(rc));
-		}
+	daos_obj_close(op->oh, NULL);
+	if (ev->ev_error && ctx->rc == 0) {
+		D_ERROR("daos_obj_punch() failed " DF_RC "\n", DP_RC(ev->ev_error));
+		ctx->rc = daos_der2errno(ev->ev_error);
 	}
+	ctx->inflight--;
+}
 
-	d_iov_set(&marker, &mark_data, sizeof(mark_data));
-	rc = daos_oit_mark(oit_args->oit, oid, &marker, NULL);
-	/*
-	 * If the entry exists but the file or directory are empty, the corresponding oid itself has
-	 * not been written to, so it doesn't exist in the OIT. The mark operation would return
-	 * NONEXIST in this case, so check and avoid returning an error in this case.
-	 */
-	if (rc && rc != -DER_NONEXIST) {
-		D_ERROR("Failed to mark OID in OIT: " DF_RC "\n", DP_RC(rc));
-		D_GOTO(out_obj, rc = daos_der2errno(rc));
-	}
+/** Punch the \a nr objects of \a oids with all punches in flight */
+static int
+punch_oids(dfs_t *dfs, struct inflight_eq *ieq, daos_obj_id_t *oids, uint32_t nr)
+{
+	struct punch_ctx ctx = {0};
+	struct punch_op *ops;
+	uint32_t         nr_init = 0;
+	uint32_t         i;
+	int              rc = 0;
+	int              rc2;
+
+	D_ASSERT(nr <= DFS_ITER_NR);
+	if (nr == 0)
+		return 0;
+
+	D_ALLOC_ARRAY(ops, nr);
+	if (ops == NULL)
+		return ENOMEM;
 
-	/** descend into directories */
-	if (S_ISDIR(obj->mode)) {
-		daos_anchor_t anchor     = {0};
-		uint32_t      nr_entries = DFS_ITER_NR;
+	for (i = 0; i < nr; i++) {
+		rc = daos_event_init(&ops[i].ev, ieq->eq, NULL);
+		if (rc)
+			D_GOTO(out, rc = daos_der2errno(rc));
+		nr_init++;
 
-		while (!daos_anchor_is_eof(&anchor)) {
-			rc = dfs_iterate(dfs, obj, &anchor, &nr_entries, DFS_MAX_NAME * nr_entries,
-					 oit_mark_cb, args);
-			if (rc) {
-				D_ERROR("dfs_iterate() failed: %d\n", rc);
-				D_GOTO(out_obj, rc);
-			}
-			nr_entries = DFS_ITER_NR;
+		rc = daos_obj_open(dfs->coh, oids[i], DAOS_OO_RW, &ops[i].oh, NULL);
+		if (rc)
+			D_GOTO(out, rc = daos_der2errno(rc));
+
+		rc = daos_obj_punch(ops[i].oh, DAOS_TX_NONE, 0, &ops[i].ev);
+		if (rc) {
+			daos_obj_close(ops[i].oh, NULL);
+			D_GOTO(out, rc = daos_der2errno(rc));
 		}
+		ctx.inflight++;
 	}
 
-out_obj:
-	rc = dfs_release(obj);
+out:
+	rc2 = inflight_eq_wait(ieq, &ctx.inflight, 0, punch_op_done, &ctx);
+	if (rc == 0)
+		rc = rc2 ? rc2 : ctx.rc;
+	/** punches that could not be aborted still reference the ops */
+	if (ctx.inflight > 0)
+		return rc;
+	for (i = 0; i < nr_init && !ieq->aborted; i++)
+		daos_event_fini(&ops[i].ev);
+	D_FREE(ops);
 	return rc;
 }
 
@@ -570,14 +872,20 @@ dfs_cont_check(daos_handle_t poh, const char *cont, uint64_t flags, const char *
 	dfs_t               *dfs;
 	daos_handle_t        coh;
 	struct dfs_oit_args *oit_args = NULL;
+	struct ns_walk       walk     = {0};
 	daos_epoch_t         snap_epoch;
 	dfs_obj_t           *lf, *now_dir;
 	daos_anchor_t        anchor            = {0};
 	uint32_t             nr_entries        = DFS_ITER_NR, i;
+	uint64_t             nr_total;
 	daos_obj_id_t        oids[DFS_ITER_NR] = {0};
 	daos_key_desc_t     *kds               = NULL;
 	char                *dkey_enum_buf     = NULL;
-	char                *entry_enum_buf    = NULL;
+	struct dfs_entry    *entries           = NULL;
+	char                *oid_names         = NULL;
+	const char          *names[DFS_ITER_NR];
+	size_t               lens[DFS_ITER_NR];
+	int                  rcs[DFS_ITER_NR];
 	uint64_t             unmarked_entries  = 0;
 	d_iov_t              marker;
 	bool                 mark_data = true;
@@ -644,17 +952,28 @@ dfs_cont_check(daos_handle_t poh, const char *cont, uint64_t flags, const char *
 		D_GOTO(out_snap, rc = daos_der2errno(rc));
 	}
 
+	/** event queue of the namespace walk and of the processing of unmarked OIDs */
+	rc = inflight_eq_create(&walk.ieq);
+	if (rc)
+		D_GOTO(out_oit, rc);
+	walk.dfs        = dfs;
+	walk.oit_args   = oit_args;
+	walk.who        = "DFS checker";
+	walk.what       = "files/directories scanned";
+	walk.start_time = now.tv_sec;
+	walk.print_time = now.tv_sec;
+
 	/** get and mark the SB and root OIDs */
 	d_iov_set(&marker, &mark_data, sizeof(mark_data));
 	rc = daos_oit_mark(oit_args->oit, dfs->super_oid, &marker, NULL);
 	if (rc) {
 		D_ERROR("Failed to mark SB OID in OIT: " DF_RC "\n", DP_RC(rc));
-		D_GOTO(out_oit, rc = daos_der2errno(rc));
+		D_GOTO(out_eq, rc = daos_der2errno(rc));
 	}
 	rc = daos_oit_mark(oit_args->oit, dfs->root.oid, &marker, NULL);
 	if (rc && rc != -DER_NONEXIST) {
 		D_ERROR("Failed to mark ROOT OID in OIT: " DF_RC "\n", DP_RC(rc));
-		D_GOTO(out_oit, rc = daos_der2errno(rc));
+		D_GOTO(out_eq, rc = daos_der2errno(rc));
 	}
 	rc = 0;
 
@@ -669,7 +988,7 @@ dfs_cont_check(daos_handle_t poh, const char *cont, uint64_t flags, const char *
 					DP_OID(dfs->super_oid));
 		} else if (rc) {
 			D_ERROR("daos_obj_verify() failed " DF_RC "\n", DP_RC(rc));
-			D_GOTO(out_oit, rc = daos_der2errno(rc));
+			D_GOTO(out_eq, rc = daos_der2errno(rc));
 		}
 
 		rc = daos_obj_verify(coh, dfs->root.oid, snap_epoch);
@@ -682,29 +1001,25 @@ dfs_cont_check(daos_handle_t poh, const char *cont, uint64_t flags, const char *
 					DP_OID(dfs->root.oid));
 		} else if (rc) {
 			D_ERROR("daos_obj_verify() failed " DF_RC "\n", DP_RC(rc));
-			D_GOTO(out_oit, rc = daos_der2errno(rc));
+			D_GOTO(out_eq, rc = daos_der2errno(rc));
 		}
 	}
 
 	D_PRINT("DFS checker: Iterating namespace and marking objects\n");
-	oit_args->num_scanned = 2;
-	/** iterate through the namespace and mark OITs starting from the root object */
-	while (!daos_anchor_is_eof(&anchor)) {
-		rc = dfs_iterate(dfs, &dfs->root, &anchor, &nr_entries, DFS_MAX_NAME * nr_entries,
-				 oit_mark_cb, oit_args);
-		if (rc) {
-			D_ERROR("dfs_iterate() failed: %d\n", rc);
-			D_GOTO(out_oit, rc);
-		}
-
-		nr_entries = DFS_ITER_NR;
+	/** walk the namespace from the root object and mark all OIDs reachable */
+	walk.num_scanned = 2;
+	walk.verify      = flags & DFS_CHECK_VERIFY;
+	rc               = ns_walk_dir(&walk, dfs->root.oid, true, &nr_total);
+	if (rc) {
+		D_ERROR("Failed to mark namespace objects: %d\n", rc);
+		D_GOTO(out_eq, rc);
 	}
 
 	rc = clock_gettime(CLOCK_REALTIME, &current_time);
 	if (rc)
-		D_GOTO(out_oit, rc = errno);
+		D_GOTO(out_eq, rc = errno);
 	D_PRINT("DFS checker: marked " DF_U64 " files/directories (runtime: " DF_U64 " sec))\n",
-		oit_args->num_scanned, current_time.tv_sec - oit_args->start_time);
+		walk.num_scanned, current_time.tv_sec - oit_args->start_time);
 
 	/** Create lost+found directory to link unmarked oids there. */
 	if (flags & DFS_CHECK_RELINK) {
@@ -712,7 +1027,7 @@ dfs_cont_check(daos_handle_t poh, const char *cont, uint64_t flags, const char *
 			      &lf);
 		if (rc) {
 			D_ERROR("Failed to create/open lost+found directory: %d\n", rc);
-			D_GOTO(out_oit, rc);
+			D_GOTO(out_eq, rc);
 		}
 
 		if (name == NULL) {
@@ -744,9 +1059,12 @@ dfs_cont_check(daos_handle_t poh, const char *cont, uint64_t flags, const char *
 		if (dkey_enum_buf == NULL)
 			D_GOTO(out_lf2, rc = ENOMEM);
 
-		/** Allocate a buffer to store the entries */
-		D_ALLOC_ARRAY(entry_enum_buf, DFS_ITER_ENTRY_BUF);
-		if (entry_enum_buf == NULL)
+		/** Allocate the entries linked in l+f, and their names, one batch at a time */
+		D_ALLOC_ARRAY(entries, DFS_ITER_NR);
+		if (entries == NULL)
+			D_GOTO(out_lf2, rc = ENOMEM);
+		D_ALLOC_ARRAY(oid_names, DFS_ITER_NR * (DFS_MAX_NAME + 1));
+		if (oid_names == NULL)
 			D_GOTO(out_lf2, rc = ENOMEM);
 	}
 
@@ -758,6 +1076,10 @@ dfs_cont_check(daos_handle_t poh, const char *cont, uint64_t flags, const char *
 	 */
 	D_PRINT("DFS checker: Checking unmarked OIDs (Pass 1)\n");
 	oit_args->num_scanned = 0;
+	walk.verify           = false;
+	/** the walks of unmarked directories only mark what they reference, count them apart */
+	walk.what        = "entries of unmarked directories marked (Pass 1)";
+	walk.num_scanned = 0;
 	memset(&anchor, 0, sizeof(anchor));
 	/** Start Pass 1 */
 	while (!daos_anchor_is_eof(&anchor)) {
@@ -768,16 +1090,9 @@ dfs_cont_check(daos_handle_t poh, const char *cont, uint64_t flags, const char *
 			D_GOTO(out_lf2, rc = daos_der2errno(rc));
 		}
 
-		clock_gettime(CLOCK_REALTIME, &current_time);
-		if (rc)
-			D_GOTO(out_lf2, rc = errno);
 		oit_args->num_scanned += nr_entries;
-		if (current_time.tv_sec - oit_args->print_time >= DFS_ELAPSED_TIME) {
-			D_PRINT("DFS checker: Checked " DF_U64 " objects (runtime: " DF_U64
-				" sec)\n",
-				oit_args->num_scanned, current_time.tv_sec - oit_args->start_time);
-			oit_args->print_time = current_time.tv_sec;
-		}
+		print_progress("DFS checker", "objects checked", oit_args->num_scanned,
+			       oit_args->start_time, &oit_args->print_time);
 
 		for (i = 0; i < nr_entries; i++) {
 			if (flags & DFS_CHECK_RELINK) {
@@ -788,7 +1103,7 @@ dfs_cont_check(daos_handle_t poh, const char *cont, uint64_t flags, const char *
 					continue;
 
 				/** for a directory, mark the oids reachable from it */
-				rc = fetch_mark_oids(coh, oids[i], kds, entry_enum_buf, oit_args);
+				rc = ns_walk_dir(&walk, oids[i], false, &nr_total);
 				if (rc)
 					D_GOTO(out_lf2, rc);
 				continue;
@@ -810,30 +1125,19 @@ dfs_cont_check(daos_handle_t poh, const char *cont, uint64_t flags, const char *
 							DP_OID(oids[i]));
 				} else if (rc) {
 					D_ERROR("daos_obj_verify() failed " DF_RC "\n", DP_RC(rc));
-					D_GOTO(out_oit, rc = daos_der2errno(rc));
+					D_GOTO(out_eq, rc = daos_der2errno(rc));
 				}
 			}
 
-			if (flags & DFS_CHECK_REMOVE) {
-				daos_handle_t oh;
-
-				rc = daos_obj_open(dfs->coh, oids[i], DAOS_OO_RW, &oh, NULL);
-				if (rc)
-					D_GOTO(out_oit, rc = daos_der2errno(rc));
-
-				rc = daos_obj_punch(oh, DAOS_TX_NONE, 0, NULL);
-				if (rc) {
-					daos_obj_close(oh, NULL);
-					D_GOTO(out_oit, rc = daos_der2errno(rc));
-				}
-
-				rc = daos_obj_close(oh, NULL);
-				if (rc)
-					D_GOTO(out_oit, rc = daos_der2errno(rc));
-			}
-
 			unmarked_entries++;
 		}
+
+		/** remove the whole batch at once, the snapshot OIT listed is not affected */
+		if (!(flags & DFS_CHECK_RELINK) && flags & DFS_CHECK_REMOVE) {
+			rc = punch_oids(dfs, &walk.ieq, oids, nr_entries);
+			if (rc)
+				D_GOTO(out_eq, rc);
+		}
 	}
 
 	/** Start Pass 2 only if L+F flag is used */
@@ -851,24 +1155,17 @@ dfs_cont_check(daos_handle_t poh, const char *cont, uint64_t flags, const char *
 			D_GOTO(out_lf2, rc = daos_der2errno(rc));
 		}
 
-		clock_gettime(CLOCK_REALTIME, &current_time);
-		if (rc)
-			D_GOTO(out_lf2, rc = errno);
 		oit_args->num_scanned += nr_entries;
-		if (current_time.tv_sec - oit_args->print_time >= DFS_ELAPSED_TIME) {
-			D_PRINT("DFS checker: Checked " DF_U64 " objects (runtime: " DF_U64
-				" sec)\n",
-				oit_args->num_scanned, current_time.tv_sec - oit_args->start_time);
-			oit_args->print_time = current_time.tv_sec;
-		}
+		print_progress("DFS checker", "objects checked", oit_args->num_scanned,
+			       oit_args->start_time, &oit_args->print_time);
 
 		for (i = 0; i < nr_entries; i++) {
-			struct dfs_entry  entry = {0};
-			enum daos_otype_t otype = daos_obj_id2type(oids[i]);
-			char              oid_name[DFS_MAX_NAME + 1];
+			struct dfs_entry *entry    = &entries[i];
+			enum daos_otype_t otype    = daos_obj_id2type(oids[i]);
+			char             *oid_name = &oid_names[i * (DFS_MAX_NAME + 1)];
 
 			if (flags & DFS_CHECK_PRINT)
-				D_PRINT("oid[" DF_U64 "]: " DF_OID "\n", unmarked_entries,
+				D_PRINT("oid[" DF_U64 "]: " DF_OID "\n", unmarked_entries + i,
 					DP_OID(oids[i]));
 
 			if (flags & DFS_CHECK_VERIFY) {
@@ -887,16 +1184,17 @@ dfs_cont_check(daos_handle_t poh, const char *cont, uint64_t flags, const char *
 				}
 			}
 
+			memset(entry, 0, sizeof(*entry));
 			if (daos_is_array_type(otype))
-				entry.mode = S_IFREG | 0600;
+				entry->mode = S_IFREG | 0600;
 			else
-				entry.mode = S_IFDIR | 0700;
-			entry.uid = uid;
-			entry.gid = gid;
-			oid_cp(&entry.oid, oids[i]);
-			entry.mtime = entry.ctime = now.tv_sec;
-			entry.mtime_nano = entry.ctime_nano = now.tv_nsec;
-			entry.chunk_size                    = dfs->attr.da_chunk_size;
+				entry->mode = S_IFDIR | 0700;
+			entry->uid = uid;
+			entry->gid = gid;
+			oid_cp(&entry->oid, oids[i]);
+			entry->mtime = entry->ctime = now.tv_sec;
+			entry->mtime_nano = entry->ctime_nano = now.tv_nsec;
+			entry->chunk_size                      = dfs->attr.da_chunk_size;
 
 			/*
 			 * If this is a regular file / array object, the user might have used a
@@ -913,25 +1211,33 @@ dfs_cont_check(daos_handle_t poh, const char *cont, uint64_t flags, const char *
 			 */
 			if (daos_is_array_type(otype)) {
 				rc = adjust_chunk_size(dfs->coh, oids[i], kds, dkey_enum_buf,
-						       &entry.chunk_size);
+						       &entry->chunk_size);
 				if (rc)
 					D_GOTO(out_lf2, rc);
 				if (flags & DFS_CHECK_PRINT &&
-				    entry.chunk_size != dfs->attr.da_chunk_size)
+				    entry->chunk_size != dfs->attr.da_chunk_size)
 					D_PRINT("Adjusting File (" DF_OID ") chunk size to %zu\n",
-						DP_OID(oids[i]), entry.chunk_size);
+						DP_OID(oids[i]), entry->chunk_size);
 			}
 
 			len = sprintf(oid_name, "%" PRIu64 ".%" PRIu64 "", oids[i].hi, oids[i].lo);
 			D_ASSERT(len <= DFS_MAX_NAME);
-			rc = insert_entry(dfs->layout_v, now_dir->oh, DAOS_TX_NONE, oid_name, len,
-					  DAOS_COND_DKEY_INSERT, &entry);
-			if (rc) {
-				D_ERROR("Failed to insert leaked entry in l+f (%d)\n", rc);
-				D_GOTO(out_lf2, rc);
+			names[i] = oid_name;
+			lens[i]  = len;
+			rcs[i]   = 0;
+		}
+
+		/** link the whole batch in l+f at once */
+		rc = insert_entries(now_dir->oh, nr_entries, names, lens, entries, rcs);
+		if (rc)
+			D_GOTO(out_lf2, rc);
+		for (i = 0; i < nr_entries; i++) {
+			if (rcs[i]) {
+				D_ERROR("Failed to insert leaked entry in l+f (%d)\n", rcs[i]);
+				D_GOTO(out_lf2, rc = rcs[i]);
 			}
-			unmarked_entries++;
 		}
+		unmarked_entries += nr_entries;
 	}
 
 done:
@@ -951,7 +1257,8 @@ done:
 out_lf2:
 	D_FREE(kds);
 	D_FREE(dkey_enum_buf);
-	D_FREE(entry_enum_buf);
+	D_FREE(entries);
+	D_FREE(oid_names);
 	if (flags & DFS_CHECK_RELINK) {
 		rc2 = dfs_release(now_dir);
 		if (rc == 0)
@@ -963,6 +1270,10 @@ out_lf1:
 		if (rc == 0)
 			rc = rc2;
 	}
+out_eq:
+	rc2 = inflight_eq_destroy(&walk.ieq);
+	if (rc == 0)
+		rc = rc2;
 out_oit:
 	rc2 = daos_oit_close(oit_args->oit, NULL);
 	if (rc == 0)
@@ -1409,101 +1720,14 @@ out_prop:
 	return rc;
 }
 
-struct dfs_scan_args {
-	time_t   start_time;
-	time_t   print_time;
-	uint64_t cur_depth;
-	uint64_t max_depth;
-	uint64_t num_files;
-	uint64_t num_dirs;
-	uint64_t num_symlinks;
-	uint64_t total_bytes;
-	uint64_t largest_file;
-	uint64_t largest_dir;
-	uint64_t num_scanned;
-};
-
-static int
-scan_cb(dfs_t *dfs, dfs_obj_t *parent, const char name[], void *args)
-{
-	struct dfs_scan_args *scan_args = (struct dfs_scan_args *)args;
-	dfs_obj_t            *obj;
-	struct timespec       current_time;
-	int                   rc;
-
-	rc = clock_gettime(CLOCK_REALTIME, &current_time);
-	if (rc)
-		return errno;
-
-	scan_args->num_scanned++;
-	if (scan_args->cur_depth > scan_args->max_depth)
-		scan_args->max_depth = scan_args->cur_depth;
-
-	if (current_time.tv_sec - scan_args->print_time >= DFS_ELAPSED_TIME) {
-		D_PRINT("DFS scanner: Scanned " DF_U64 " files/directories (runtime: " DF_U64
-			" sec)\n",
-			scan_args->num_scanned, current_time.tv_sec - scan_args->start_time);
-		scan_args->print_time = current_time.tv_sec;
-	}
-
-	/** open the entry name */
-	rc = dfs_lookup_rel(dfs, parent, name, O_RDONLY | O_NOFOLLOW, &obj, NULL, NULL);
-	if (rc) {
-		D_ERROR("dfs_lookup_rel() of %s failed: %d\n", name, rc);
-		return rc;
-	}
-
-	/** descend into directories */
-	if (S_ISDIR(obj->mode)) {
-		daos_anchor_t anchor     = {0};
-		uint32_t      nr_entries = DFS_ITER_NR;
-		uint64_t      nr_total   = 0;
-
-		scan_args->num_dirs++;
-		while (!daos_anchor_is_eof(&anchor)) {
-			scan_args->cur_depth++;
-			rc = dfs_iterate(dfs, obj, &anchor, &nr_entries, DFS_MAX_NAME * nr_entries,
-					 scan_cb, args);
-			scan_args->cur_depth--;
-			if (rc) {
-				D_ERROR("dfs_iterate() failed: %d\n", rc);
-				D_GOTO(out_obj, rc);
-			}
-			nr_total += nr_entries;
-			nr_entries = DFS_ITER_NR;
-		}
-		if (scan_args->largest_dir < nr_total)
-			scan_args->largest_dir = nr_total;
-	} else if (S_ISLNK(obj->mode)) {
-		scan_args->num_symlinks++;
-	} else {
-		struct stat stbuf;
-
-		scan_args->num_files++;
-		rc = dfs_ostat(dfs, obj, &stbuf);
-		if (rc) {
-			D_ERROR("dfs_ostat() failed: %d\n", rc);
-			D_GOTO(out_obj, rc);
-		}
-		scan_args->total_bytes += stbuf.st_size;
-		if (scan_args->largest_file < stbuf.st_size)
-			scan_args->largest_file = stbuf.st_size;
-	}
-
-out_obj:
-	rc = dfs_release(obj);
-	return rc;
-}
-
 int
 dfs_cont_scan(daos_handle_t poh, const char *cont, uint64_t flags, const char *subdir)
 {
 	dfs_t               *dfs;
 	daos_handle_t        coh;
-	struct dfs_scan_args scan_args  = {0};
-	daos_anchor_t        anchor     = {0};
-	uint32_t             nr_entries = DFS_ITER_NR;
-	uint64_t             nr_total   = 0;
+	struct dfs_scan_args scan_args = {0};
+	struct ns_walk       walk      = {0};
+	uint64_t             nr_total  = 0;
 	struct timespec      now, current_time;
 	char                 now_name[24];
 	struct tm           *now_tm;
@@ -1532,23 +1756,30 @@ dfs_cont_scan(daos_handle_t poh, const char *cont, uint64_t flags, const char *s
 	}
 
 	scan_args.start_time = now.tv_sec;
-	scan_args.print_time = now.tv_sec;
-	scan_args.cur_depth  = 1; /** starting from root at depth 1 */
 
-	/** TODO: add support for starting from the subdir args */
+	rc = inflight_eq_create(&walk.ieq);
+	if (rc)
+		D_GOTO(out, rc);
+	walk.dfs        = dfs;
+	walk.scan_args  = &scan_args;
+	walk.who        = "DFS scanner";
+	walk.what       = "files/directories scanned";
+	walk.depth      = 1; /** starting from root at depth 1 */
+	walk.start_time = now.tv_sec;
+	walk.print_time = now.tv_sec;
 
-	/** iterate through the namespace */
-	while (!daos_anchor_is_eof(&anchor)) {
-		rc = dfs_iterate(dfs, &dfs->root, &anchor, &nr_entries, DFS_MAX_NAME * nr_entries,
-				 scan_cb, &scan_args);
-		if (rc) {
-			D_ERROR("dfs_iterate() failed: %d\n", rc);
-			D_GOTO(out, rc);
-		}
+	/** TODO: add support for starting from the subdir args */
 
-		nr_total += nr_entries;
-		nr_entries = DFS_ITER_NR;
+	/** walk the namespace, a batch of entries in flight per directory */
+	rc  = ns_walk_dir(&walk, dfs->root.oid, true, &nr_total);
+	rc2 = inflight_eq_destroy(&walk.ieq);
+	if (rc == 0)
+		rc = rc2;
+	if (rc) {
+		D_ERROR("Failed to scan namespace: %d\n", rc);
+		D_GOTO(out, rc);
 	}
+	scan_args.num_scanned = walk.num_scanned;
 
 	if (scan_args.largest_dir < nr_total)
 		scan_args.largest_dir = nr_total;
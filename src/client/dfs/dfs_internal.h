@@ -230,6 +230,16 @@ struct dfs_mnt_hdls {
 	int           type;
 };
 
+/** Event queue on which a bounded number of asynchronous operations is kept in flight */
+struct inflight_eq {
+	daos_handle_t eq;
+	/** the EQ could not be polled and was destroyed, aborting every operation in flight */
+	bool          aborted;
+};
+
+/** Handed every event completed while waiting in inflight_eq_wait() */
+typedef void (*inflight_eq_cb_t)(void *arg, daos_event_t *ev);
+
 static inline bool
 tspec_gt(struct timespec l, struct timespec r)
 {
@@ -396,6 +406,28 @@ open_sb(daos_handle_t coh, bool create, bool punch, int omode, daos_obj_id_t sup
 int
 insert_entry(dfs_layout_ver_t ver, daos_handle_t oh, daos_handle_t th, const char *name, size_t len,
 	     uint64_t flags, struct dfs_entry *entry);
+/*
+ * Insert \a nr entries into the directory object \a oh with conditional inserts kept in flight
+ * concurrently. Entries whose \a rcs is non-zero on input are skipped. On return, \a rcs holds the
+ * result of each insert (EEXIST if the name is taken).
+ */
+int
+insert_entries(daos_handle_t oh, uint32_t nr, const char **names, size_t *lens,
+	       struct dfs_entry *entries, int *rcs);
+int
+inflight_eq_create(struct inflight_eq *ieq);
+/*
+ * Poll \a ieq until at most \a max of the operations counted by \a inflight are still in flight.
+ * Every completed event is handed to \a cb, which must decrement the counter of the operation the
+ * event belongs to. If the EQ can't be polled, it is destroyed to abort all operations in flight
+ * and \a inflight is reset; if even that fails, \a inflight is left as is and the memory those
+ * operations reference must not be released.
+ */
+int
+inflight_eq_wait(struct inflight_eq *ieq, uint32_t *inflight, uint32_t max, inflight_eq_cb_t cb,
+		 void *arg);
+int
+inflight_eq_destroy(struct inflight_eq *ieq);
 int
 fetch_entry(dfs_layout_ver_t ver, daos_handle_t oh, daos_handle_t th, const char *name, size_t len,
 	    bool fetch_sym, bool *exists, struct dfs_entry *entry, int xnr, char *xnames[],
@@ -68,68 +68,430 @@ dfs_mkdir(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode, daos_ocl
 	return rc;
 }
 
+/** Insert \a nr entries of the same type in \a parent, filling the per-entry results in \a rcs */
 static int
-remove_dir_contents(dfs_t *dfs, daos_handle_t th, struct dfs_entry entry)
+create_batch(dfs_t *dfs, dfs_obj_t *parent, const char **names, uint32_t nr, mode_t mode,
+	     daos_oclass_id_t cid, daos_size_t chunk_size, int *rcs)
 {
+	struct dfs_entry *entries;
+	size_t           *lens;
+	struct timespec   now;
+	bool              dir = S_ISDIR(mode);
+	uint32_t          i;
+	int               rc;
+
+	if (dfs == NULL || !dfs->mounted)
+		return EINVAL;
+	if (dfs->amode != O_RDWR)
+		return EPERM;
+	if (names == NULL || rcs == NULL)
+		return EINVAL;
+	if (parent == NULL)
+		parent = &dfs->root;
+	else if (!S_ISDIR(parent->mode))
+		return ENOTDIR;
+	if (nr == 0)
+		return 0;
+
+	/** set oclass and chunk size. order: API, parent dir, cont default */
+	if (cid == 0) {
+		if (parent->d.oclass != 0)
+			cid = parent->d.oclass;
+		else
+			cid = dir ? dfs->attr.da_dir_oclass_id : dfs->attr.da_file_oclass_id;
+	}
+	if (chunk_size == 0) {
+		if (parent->d.chunk_size != 0)
+			chunk_size = parent->d.chunk_size;
+		else
+			chunk_size = dfs->attr.da_chunk_size;
+	}
+
+	rc = clock_gettime(CLOCK_REALTIME, &now);
+	if (rc)
+		return errno;
+
+	D_ALLOC_ARRAY(entries, nr);
+	if (entries == NULL)
+		return ENOMEM;
+	D_ALLOC_ARRAY(lens, nr);
+	if (lens == NULL)
+		D_GOTO(out, rc = ENOMEM);
+
+	for (i = 0; i < nr; i++) {
+		struct dfs_entry *entry = &entries[i];
+
+		rcs[i] = check_name(names[i], &lens[i]);
+		if (rcs[i])
+			continue;
+
+		/** OIDs come from the range the mount already reserved, no RPC needed */
+		rcs[i] = oid_gen(dfs, cid, !dir, &entry->oid);
+		if (rcs[i])
+			continue;
+
+		entry->mode  = mode;
+		entry->mtime = entry->ctime = now.tv_sec;
+		entry->mtime_nano = entry->ctime_nano = now.tv_nsec;
+		entry->uid                            = geteuid();
+		entry->gid                            = getegid();
+		entry->chunk_size                     = dir ? parent->d.chunk_size : chunk_size;
+		if (dir)
+			entry->oclass = parent->d.oclass;
+	}
+
+	rc = insert_entries(parent->oh, nr, names, lens, entries, rcs);
+
+out:
+	D_FREE(lens);
+	D_FREE(entries);
+	return rc;
+}
+
+int
+dfs_mkdir_batch(dfs_t *dfs, dfs_obj_t *parent, const char **names, uint32_t nr, mode_t mode,
+		daos_oclass_id_t cid, int *rcs)
+{
+	return create_batch(dfs, parent, names, nr, S_IFDIR | mode, cid, 0, rcs);
+}
+
+int
+dfs_create_batch(dfs_t *dfs, dfs_obj_t *parent, const char **names, uint32_t nr, mode_t mode,
+		 daos_oclass_id_t cid, daos_size_t chunk_size, int *rcs)
+{
+	return create_batch(dfs, parent, names, nr, S_IFREG | (mode & ~S_IFMT), cid, chunk_size,
+			    rcs);
+}
+
+/** Number of entries enumerated, and kept in flight, per directory during a recursive remove */
+#define RM_ENUM_NR       128
+#define RM_ENUM_BUF      (RM_ENUM_NR * DFS_MAX_NAME)
+/** Interval in seconds between progress messages of a recursive remove */
+#define RM_ELAPSED_TIME  30
+
+enum rm_stage {
+	RM_FETCH,
+	RM_FETCHED,
+	RM_PUNCH_OBJ,
+	RM_PUNCH_DKEY,
+	RM_DONE,
+};
+
+struct rm_batch;
+
+/** One directory entry being removed; driven through its stages by the event queue */
+struct rm_op {
+	daos_event_t     ev;
+	struct rm_batch *batch;
+	enum rm_stage    stage;
+	struct dfs_entry entry;
+	daos_handle_t    oh;
+	daos_key_t       dkey;
+	daos_iod_t       iod;
+	daos_recx_t      recx;
+	d_sg_list_t      sgl;
+	d_iov_t          sg_iovs[2];
+};
+
+/** One enumeration batch of a directory */
+struct rm_batch {
 	daos_handle_t   oh;
-	daos_key_desc_t kds[ENUM_DESC_NR];
-	daos_anchor_t   anchor = {0};
-	d_iov_t         iov;
-	char            enum_buf[ENUM_DESC_BUF] = {0};
-	d_sg_list_t     sgl;
+	uint32_t        inflight;
 	int             rc;
+	struct rm_op    ops[RM_ENUM_NR];
+	daos_key_desc_t kds[RM_ENUM_NR];
+	char            enum_buf[RM_ENUM_BUF];
+};
+
+/** State shared by the whole recursive remove */
+struct rm_ctx {
+	dfs_t             *dfs;
+	daos_handle_t      th;
+	struct inflight_eq ieq;
+	uint64_t           num_removed;
+	time_t             start_time;
+	time_t             print_time;
+};
+
+static void
+rm_progress(struct rm_ctx *ctx)
+{
+	struct timespec now;
+
+	ctx->num_removed++;
+	if (clock_gettime(CLOCK_MONOTONIC, &now))
+		return;
+	if (now.tv_sec - ctx->print_time >= RM_ELAPSED_TIME) {
+		D_INFO("DFS remove: removed " DF_U64 " entries (runtime: " DF_U64 " sec)\n",
+		       ctx->num_removed, (uint64_t)(now.tv_sec - ctx->start_time));
+		ctx->print_time = now.tv_sec;
+	}
+}
+
+static void
+rm_op_fail(struct rm_op *op, int rc)
+{
+	if (op->batch->rc == 0)
+		op->batch->rc = rc;
+	op->stage = RM_DONE;
+}
+
+/** Punch the entry of \a op in its parent directory */
+static void
+rm_op_punch_dkey(struct rm_ctx *ctx, struct rm_op *op)
+{
+	int rc;
+
+	op->stage = RM_PUNCH_DKEY;
+	/** we only need a conditional dkey punch if we are not using a DTX */
+	rc = daos_obj_punch_dkeys(op->batch->oh, ctx->th, ctx->dfs->use_dtx ? 0 : DAOS_COND_PUNCH,
+				  1, &op->dkey, &op->ev);
+	if (rc)
+		rm_op_fail(op, daos_der2errno(rc));
+	else
+		op->batch->inflight++;
+}
+
+/** Punch the object of \a op, the entry itself is punched once that completes */
+static void
+rm_op_punch_obj(struct rm_ctx *ctx, struct rm_op *op)
+{
+	int rc;
+
+	if (S_ISLNK(op->entry.mode)) {
+		rm_op_punch_dkey(ctx, op);
+		return;
+	}
+
+	rc = daos_obj_open(ctx->dfs->coh, op->entry.oid, DAOS_OO_RW, &op->oh, NULL);
+	if (rc) {
+		rm_op_fail(op, daos_der2errno(rc));
+		return;
+	}
+
+	op->stage = RM_PUNCH_OBJ;
+	rc = daos_obj_punch(op->oh, ctx->th, 0, &op->ev);
+	if (rc) {
+		daos_obj_close(op->oh, NULL);
+		rm_op_fail(op, daos_der2errno(rc));
+		return;
+	}
+	op->batch->inflight++;
+}
+
+/** Fetch the mode and OID of the entry of \a op */
+static void
+rm_op_fetch(struct rm_ctx *ctx, struct rm_op *op, char *name, size_t len)
+{
+	int rc;
+
+	d_iov_set(&op->dkey, name, len);
+	d_iov_set(&op->iod.iod_name, INODE_AKEY_NAME, sizeof(INODE_AKEY_NAME) - 1);
+	op->iod.iod_nr    = 1;
+	op->recx.rx_idx   = 0;
+	op->recx.rx_nr    = MTIME_IDX;
+	op->iod.iod_recxs = &op->recx;
+	op->iod.iod_type  = DAOS_IOD_ARRAY;
+	op->iod.iod_size  = 1;
+
+	d_iov_set(&op->sg_iovs[0], &op->entry.mode, sizeof(mode_t));
+	d_iov_set(&op->sg_iovs[1], &op->entry.oid, sizeof(daos_obj_id_t));
+	op->sgl.sg_nr     = 2;
+	op->sgl.sg_nr_out = 0;
+	op->sgl.sg_iovs   = op->sg_iovs;
+
+	op->stage = RM_FETCH;
+	rc = daos_obj_fetch(op->batch->oh, ctx->th, DAOS_COND_DKEY_FETCH, &op->dkey, 1, &op->iod,
+			    &op->sgl, NULL, &op->ev);
+	if (rc)
+		rm_op_fail(op, daos_der2errno(rc));
+	else
+		op->batch->inflight++;
+}
+
+/** Advance the op of \a ev to its next stage after its in-flight operation completed */
+static void
+rm_op_complete(void *arg, daos_event_t *ev)
+{
+	struct rm_ctx *ctx = arg;
+	struct rm_op  *op  = container_of(ev, struct rm_op, ev);
+	int            rc  = ev->ev_error;
+
+	op->batch->inflight--;
+
+	switch (op->stage) {
+	case RM_FETCH:
+		/** entry removed concurrently, nothing left to do */
+		if (rc == -DER_NONEXIST || (rc == 0 && op->sgl.sg_nr_out == 0)) {
+			op->stage = RM_DONE;
+			break;
+		}
+		if (rc) {
+			D_ERROR("Failed to fetch entry " DF_RC "\n", DP_RC(rc));
+			rm_op_fail(op, daos_der2errno(rc));
+			break;
+		}
+		op->stage = RM_FETCHED;
+		break;
+	case RM_PUNCH_OBJ:
+		daos_obj_close(op->oh, NULL);
+		if (rc) {
+			rm_op_fail(op, daos_der2errno(rc));
+			break;
+		}
+		rm_op_punch_dkey(ctx, op);
+		break;
+	case RM_PUNCH_DKEY:
+		if (rc && rc != -DER_NONEXIST) {
+			rm_op_fail(op, daos_der2errno(rc));
+			break;
+		}
+		op->stage = RM_DONE;
+		rm_progress(ctx);
+		break;
+	default:
+		D_ASSERTF(0, "unexpected stage %d\n", op->stage);
+	}
+}
+
+/**
+ * Wait until all operations of \a batch completed. Completions of any other batch (i.e. of the
+ * parent directories) polled in the meantime are processed as well.
+ */
+static int
+rm_batch_drain(struct rm_ctx *ctx, struct rm_batch *batch)
+{
+	return inflight_eq_wait(&ctx->ieq, &batch->inflight, 0, rm_op_complete, ctx);
+}
+
+static int
+remove_dir_contents(struct rm_ctx *ctx, struct dfs_entry entry)
+{
+	struct rm_batch *batch;
+	daos_anchor_t    anchor = {0};
+	d_iov_t          iov;
+	d_sg_list_t      sgl;
+	int              nr_ev  = 0;
+	int              rc;
+	int              rc2;
+	int              i;
 
 	D_ASSERT(S_ISDIR(entry.mode));
 
-	rc = daos_obj_open(dfs->coh, entry.oid, DAOS_OO_RW, &oh, NULL);
+	D_ALLOC_PTR(batch);
+	if (batch == NULL)
+		return ENOMEM;
+
+	rc = daos_obj_open(ctx->dfs->coh, entry.oid, DAOS_OO_RW, &batch->oh, NULL);
 	if (rc)
-		return daos_der2errno(rc);
+		D_GOTO(out_free, rc = daos_der2errno(rc));
+
+	for (nr_ev = 0; nr_ev < RM_ENUM_NR; nr_ev++) {
+		batch->ops[nr_ev].batch = batch;
+		rc = daos_event_init(&batch->ops[nr_ev].ev, ctx->ieq.eq, NULL);
+		if (rc)
+			D_GOTO(out, rc = daos_der2errno(rc));
+	}
 
 	sgl.sg_nr     = 1;
 	sgl.sg_nr_out = 0;
-	d_iov_set(&iov, enum_buf, ENUM_DESC_BUF);
+	d_iov_set(&iov, batch->enum_buf, RM_ENUM_BUF);
 	sgl.sg_iovs = &iov;
 
 	while (!daos_anchor_is_eof(&anchor)) {
-		uint32_t number = ENUM_DESC_NR;
-		uint32_t i;
+		uint32_t number = RM_ENUM_NR;
 		char    *ptr;
 
-		rc = daos_obj_list_dkey(oh, th, &number, kds, &sgl, &anchor, NULL);
+		rc = daos_obj_list_dkey(batch->oh, ctx->th, &number, batch->kds, &sgl, &anchor,
+					NULL);
 		if (rc)
 			D_GOTO(out, rc = daos_der2errno(rc));
 
 		if (number == 0)
 			continue;
 
-		for (ptr = enum_buf, i = 0; i < number; i++) {
-			struct dfs_entry child_entry = {0};
-			bool             exists;
+		/** look up all entries of the batch at once */
+		for (ptr = batch->enum_buf, i = 0; i < number; i++) {
+			rm_op_fetch(ctx, &batch->ops[i], ptr, batch->kds[i].kd_key_len);
+			ptr += batch->kds[i].kd_key_len;
+		}
+		rc = rm_batch_drain(ctx, batch);
+		if (rc == 0)
+			rc = batch->rc;
+		if (rc)
+			D_GOTO(out, rc);
 
-			ptr += kds[i].kd_key_len;
+		/** start punching files and symlinks while the sub-directories are emptied */
+		for (i = 0; i < number; i++) {
+			if (batch->ops[i].stage == RM_FETCHED && !S_ISDIR(batch->ops[i].entry.mode))
+				rm_op_punch_obj(ctx, &batch->ops[i]);
+		}
 
-			rc = fetch_entry(dfs->layout_v, oh, th, ptr, kds[i].kd_key_len, false,
-					 &exists, &child_entry, 0, NULL, NULL, NULL);
-			if (rc)
-				D_GOTO(out, rc);
+		for (i = 0; i < number && batch->rc == 0; i++) {
+			struct rm_op *op = &batch->ops[i];
 
-			if (!exists)
+			if (op->stage != RM_FETCHED)
 				continue;
 
-			if (S_ISDIR(child_entry.mode)) {
-				rc = remove_dir_contents(dfs, th, child_entry);
-				if (rc)
-					D_GOTO(out, rc);
+			rc = remove_dir_contents(ctx, op->entry);
+			if (rc) {
+				rm_op_fail(op, rc);
+				break;
 			}
-
-			rc = remove_entry(dfs, th, oh, ptr, kds[i].kd_key_len, child_entry);
-			if (rc)
-				D_GOTO(out, rc);
+			rm_op_punch_obj(ctx, op);
 		}
+
+		rc = rm_batch_drain(ctx, batch);
+		if (rc == 0)
+			rc = batch->rc;
+		if (rc)
+			D_GOTO(out, rc);
 	}
 
 out:
-	daos_obj_close(oh, NULL);
+	rc2 = rm_batch_drain(ctx, batch);
+	if (rc == 0)
+		rc = rc2;
+	/** operations that could not be aborted still reference the batch */
+	if (batch->inflight > 0)
+		return rc;
+	for (i = 0; i < nr_ev && !ctx->ieq.aborted; i++)
+		daos_event_fini(&batch->ops[i].ev);
+	daos_obj_close(batch->oh, NULL);
+out_free:
+	D_FREE(batch);
+	return rc;
+}
+
+/** Remove the contents of a directory, keeping many lookups and punches in flight */
+static int
+remove_dir_contents_parallel(dfs_t *dfs, daos_handle_t th, struct dfs_entry entry)
+{
+	struct rm_ctx   ctx = {0};
+	struct timespec now;
+	int             rc;
+	int             rc2;
+
+	rc = clock_gettime(CLOCK_MONOTONIC, &now);
+	if (rc)
+		return errno;
+
+	ctx.dfs        = dfs;
+	ctx.th         = th;
+	ctx.start_time = ctx.print_time = now.tv_sec;
+
+	rc = inflight_eq_create(&ctx.ieq);
+	if (rc)
+		return rc;
+
+	rc = remove_dir_contents(&ctx, entry);
+
+	if (ctx.num_removed > 0 && ctx.print_time != ctx.start_time)
+		D_INFO("DFS remove: done, removed " DF_U64 " entries: %d\n", ctx.num_removed, rc);
+
+	rc2 = inflight_eq_destroy(&ctx.ieq);
+	if (rc == 0)
+		rc = rc2;
 	return rc;
 }
 
@@ -198,7 +560,7 @@ restart:
 			D_GOTO(out, rc = ENOTEMPTY);
 
 		if (force && nr != 0) {
-			rc = remove_dir_contents(dfs, th, entry);
+			rc = remove_dir_contents_parallel(dfs, th, entry);
 			if (rc)
 				D_GOTO(out, rc);
 		}
@@ -288,6 +650,524 @@ out:
 	return rc;
 }
 
+/** Number of entries enumerated, and copied concurrently, at a time when promoting a directory */
+#define PROMOTE_ENUM_NR  128
+#define PROMOTE_ENUM_BUF (PROMOTE_ENUM_NR * DFS_MAX_NAME)
+/** Number of akeys of an entry listed at a time, the longest is an xattr ("x:" + name) */
+#define PROMOTE_AKEY_NR  8
+#define PROMOTE_AKEY_LEN (DFS_MAX_XATTR_NAME + 2)
+
+enum promote_stage {
+	PROMOTE_LIST,
+	PROMOTE_SIZE,
+	PROMOTE_FETCH,
+	PROMOTE_UPDATE,
+	PROMOTE_DONE,
+};
+
+struct promote_batch;
+
+/**
+ * One entry copied to the new directory object as a whole dkey: its akeys (inode, symlink value,
+ * xattrs) are listed, their sizes queried if needed, fetched and inserted in a single update.
+ */
+struct promote_op {
+	daos_event_t          ev;
+	struct promote_batch *batch;
+	enum promote_stage    stage;
+	daos_key_t            dkey;
+	daos_anchor_t         anchor;
+	/** akeys listed so far, and how many the list in flight returned */
+	uint32_t              nr_akeys;
+	uint32_t              nr_listed;
+	daos_key_desc_t      *kds;
+	char                 *akeys;
+	size_t                akeys_len;
+	d_iov_t               list_iov;
+	d_sg_list_t           list_sgl;
+	/** one iod and sgl per akey */
+	daos_iod_t           *iods;
+	d_sg_list_t          *sgls;
+	d_iov_t              *iovs;
+	char                 *vals;
+	daos_recx_t           recx;
+};
+
+/** One enumeration batch of the directory being promoted */
+struct promote_batch {
+	daos_handle_t      src_oh;
+	daos_handle_t      dst_oh;
+	struct inflight_eq ieq;
+	uint32_t           inflight;
+	int                rc;
+	struct promote_op  ops[PROMOTE_ENUM_NR];
+	daos_key_desc_t    kds[PROMOTE_ENUM_NR];
+	char               enum_buf[PROMOTE_ENUM_BUF];
+};
+
+static void
+promote_op_fail(struct promote_op *op, int rc)
+{
+	if (op->batch->rc == 0)
+		op->batch->rc = rc;
+	op->stage = PROMOTE_DONE;
+}
+
+static void
+promote_op_reset(struct promote_op *op)
+{
+	D_FREE(op->kds);
+	D_FREE(op->akeys);
+	D_FREE(op->iods);
+	D_FREE(op->sgls);
+	D_FREE(op->iovs);
+	D_FREE(op->vals);
+	op->nr_akeys  = 0;
+	op->akeys_len = 0;
+	memset(&op->anchor, 0, sizeof(op->anchor));
+}
+
+/** List the next PROMOTE_AKEY_NR akeys of the entry of \a op */
+static void
+promote_op_list(struct promote_op *op)
+{
+	daos_key_desc_t *kds;
+	char            *akeys;
+	int              rc;
+
+	D_REALLOC_ARRAY(kds, op->kds, op->nr_akeys, op->nr_akeys + PROMOTE_AKEY_NR);
+	if (kds == NULL) {
+		promote_op_fail(op, ENOMEM);
+		return;
+	}
+	op->kds = kds;
+	D_REALLOC(akeys, op->akeys, op->akeys_len,
+		  op->akeys_len + PROMOTE_AKEY_NR * PROMOTE_AKEY_LEN);
+	if (akeys == NULL) {
+		promote_op_fail(op, ENOMEM);
+		return;
+	}
+	op->akeys = akeys;
+
+	d_iov_set(&op->list_iov, op->akeys + op->akeys_len, PROMOTE_AKEY_NR * PROMOTE_AKEY_LEN);
+	op->list_sgl.sg_nr     = 1;
+	op->list_sgl.sg_nr_out = 0;
+	op->list_sgl.sg_iovs   = &op->list_iov;
+	op->nr_listed          = PROMOTE_AKEY_NR;
+
+	op->stage = PROMOTE_LIST;
+	rc = daos_obj_list_akey(op->batch->src_oh, DAOS_TX_NONE, &op->dkey, &op->nr_listed,
+				&op->kds[op->nr_akeys], &op->list_sgl, &op->anchor, &op->ev);
+	if (rc)
+		promote_op_fail(op, daos_der2errno(rc));
+	else
+		op->batch->inflight++;
+}
+
+/**
+ * Set up one iod per listed akey of \a op: the inode is an array, the other akeys are single
+ * values of unknown size, in which case \a query_size is set.
+ */
+static int
+promote_op_set_iods(struct promote_op *op, bool *query_size)
+{
+	char    *name = op->akeys;
+	uint32_t i;
+
+	D_ALLOC_ARRAY(op->iods, op->nr_akeys);
+	D_ALLOC_ARRAY(op->sgls, op->nr_akeys);
+	D_ALLOC_ARRAY(op->iovs, op->nr_akeys);
+	if (op->iods == NULL || op->sgls == NULL || op->iovs == NULL)
+		return ENOMEM;
+
+	*query_size = false;
+	for (i = 0; i < op->nr_akeys; i++) {
+		daos_iod_t *iod = &op->iods[i];
+
+		d_iov_set(&iod->iod_name, name, op->kds[i].kd_key_len);
+		name += op->kds[i].kd_key_len;
+		iod->iod_nr = 1;
+		if (iod->iod_name.iov_len == sizeof(INODE_AKEY_NAME) - 1 &&
+		    memcmp(iod->iod_name.iov_buf, INODE_AKEY_NAME, iod->iod_name.iov_len) == 0) {
+			op->recx.rx_idx = 0;
+			op->recx.rx_nr  = END_IDX;
+			iod->iod_recxs  = &op->recx;
+			iod->iod_type   = DAOS_IOD_ARRAY;
+			iod->iod_size   = 1;
+		} else {
+			iod->iod_recxs = NULL;
+			iod->iod_type  = DAOS_IOD_SINGLE;
+			iod->iod_size  = DAOS_REC_ANY;
+			*query_size    = true;
+		}
+		op->sgls[i].sg_nr     = 1;
+		op->sgls[i].sg_nr_out = 0;
+		op->sgls[i].sg_iovs   = &op->iovs[i];
+	}
+	return 0;
+}
+
+/** Query the sizes of the single value akeys of \a op */
+static void
+promote_op_size(struct promote_op *op)
+{
+	int rc;
+
+	op->stage = PROMOTE_SIZE;
+	rc        = daos_obj_fetch(op->batch->src_oh, DAOS_TX_NONE, 0, &op->dkey, op->nr_akeys,
+				   op->iods, NULL, NULL, &op->ev);
+	if (rc)
+		promote_op_fail(op, daos_der2errno(rc));
+	else
+		op->batch->inflight++;
+}
+
+/** Fetch all akeys of \a op, whose sizes are known */
+static void
+promote_op_fetch(struct promote_op *op)
+{
+	daos_size_t total = 0;
+	char       *val;
+	uint32_t    i;
+	int         rc;
+
+	for (i = 0; i < op->nr_akeys; i++)
+		total += op->iods[i].iod_size * (op->iods[i].iod_type == DAOS_IOD_ARRAY ? END_IDX : 1);
+	D_ALLOC(op->vals, total);
+	if (op->vals == NULL) {
+		promote_op_fail(op, ENOMEM);
+		return;
+	}
+
+	for (val = op->vals, i = 0; i < op->nr_akeys; i++) {
+		daos_size_t size = op->iods[i].iod_size;
+
+		if (op->iods[i].iod_type == DAOS_IOD_ARRAY)
+			size *= END_IDX;
+		d_iov_set(&op->iovs[i], val, size);
+		val += size;
+	}
+
+	op->stage = PROMOTE_FETCH;
+	rc = daos_obj_fetch(op->batch->src_oh, DAOS_TX_NONE, 0, &op->dkey, op->nr_akeys, op->iods,
+			    op->sgls, NULL, &op->ev);
+	if (rc)
+		promote_op_fail(op, daos_der2errno(rc));
+	else
+		op->batch->inflight++;
+}
+
+/** Insert the fetched entry of \a op in the new directory object */
+static void
+promote_op_update(struct promote_op *op)
+{
+	uint32_t i;
+	int      rc;
+
+	/** the fetch may have trimmed the iovs, write back whole values */
+	for (i = 0; i < op->nr_akeys; i++)
+		op->iovs[i].iov_len = op->iovs[i].iov_buf_len;
+
+	op->stage = PROMOTE_UPDATE;
+	rc = daos_obj_update(op->batch->dst_oh, DAOS_TX_NONE, DAOS_COND_DKEY_INSERT, &op->dkey,
+			     op->nr_akeys, op->iods, op->sgls, &op->ev);
+	if (rc)
+		promote_op_fail(op, daos_der2errno(rc));
+	else
+		op->batch->inflight++;
+}
+
+/** Advance the op of \a ev to its next stage after its in-flight operation completed */
+static void
+promote_op_complete(void *arg, daos_event_t *ev)
+{
+	struct promote_op *op = container_of(ev, struct promote_op, ev);
+	bool               query_size;
+	uint32_t           i;
+	int                rc = ev->ev_error;
+
+	op->batch->inflight--;
+	if (rc) {
+		D_ERROR("Failed to copy entry %.*s at stage %d: " DF_RC "\n",
+			(int)op->dkey.iov_len, (char *)op->dkey.iov_buf, op->stage, DP_RC(rc));
+		promote_op_fail(op, daos_der2errno(rc));
+		return;
+	}
+
+	switch (op->stage) {
+	case PROMOTE_LIST:
+		for (i = 0; i < op->nr_listed; i++)
+			op->akeys_len += op->kds[op->nr_akeys + i].kd_key_len;
+		op->nr_akeys += op->nr_listed;
+		if (!daos_anchor_is_eof(&op->anchor)) {
+			promote_op_list(op);
+			break;
+		}
+		rc = promote_op_set_iods(op, &query_size);
+		if (rc) {
+			promote_op_fail(op, rc);
+			break;
+		}
+		if (query_size)
+			promote_op_size(op);
+		else
+			promote_op_fetch(op);
+		break;
+	case PROMOTE_SIZE:
+		promote_op_fetch(op);
+		break;
+	case PROMOTE_FETCH:
+		promote_op_update(op);
+		break;
+	case PROMOTE_UPDATE:
+		op->stage = PROMOTE_DONE;
+		break;
+	default:
+		D_ASSERTF(0, "unexpected stage %d\n", op->stage);
+	}
+}
+
+/**
+ * Copy every entry of directory object \a src_oh, with all its akeys, to \a dst_oh. The entries
+ * of each enumerated batch are copied concurrently.
+ */
+static int
+promote_copy_entries(daos_handle_t src_oh, daos_handle_t dst_oh, uint64_t *nr_copied)
+{
+	struct promote_batch *batch;
+	daos_anchor_t         anchor = {0};
+	d_iov_t               iov;
+	d_sg_list_t           sgl;
+	int                   nr_ev = 0;
+	int                   rc;
+	int                   rc2;
+	int                   i;
+
+	D_ALLOC_PTR(batch);
+	if (batch == NULL)
+		return ENOMEM;
+	batch->src_oh = src_oh;
+	batch->dst_oh = dst_oh;
+
+	rc = inflight_eq_create(&batch->ieq);
+	if (rc)
+		D_GOTO(out_free, rc);
+
+	for (nr_ev = 0; nr_ev < PROMOTE_ENUM_NR; nr_ev++) {
+		batch->ops[nr_ev].batch = batch;
+		rc = daos_event_init(&batch->ops[nr_ev].ev, batch->ieq.eq, NULL);
+		if (rc)
+			D_GOTO(out, rc = daos_der2errno(rc));
+	}
+
+	sgl.sg_nr     = 1;
+	sgl.sg_nr_out = 0;
+	d_iov_set(&iov, batch->enum_buf, PROMOTE_ENUM_BUF);
+	sgl.sg_iovs = &iov;
+
+	*nr_copied = 0;
+	while (!daos_anchor_is_eof(&anchor)) {
+		uint32_t number = PROMOTE_ENUM_NR;
+		char    *ptr;
+
+		rc = daos_obj_list_dkey(src_oh, DAOS_TX_NONE, &number, batch->kds, &sgl, &anchor,
+					NULL);
+		if (rc) {
+			D_ERROR("daos_obj_list_dkey() failed " DF_RC "\n", DP_RC(rc));
+			D_GOTO(out, rc = daos_der2errno(rc));
+		}
+
+		for (ptr = batch->enum_buf, i = 0; i < number; i++) {
+			d_iov_set(&batch->ops[i].dkey, ptr, batch->kds[i].kd_key_len);
+			ptr += batch->kds[i].kd_key_len;
+			promote_op_list(&batch->ops[i]);
+		}
+
+		rc = inflight_eq_wait(&batch->ieq, &batch->inflight, 0, promote_op_complete, batch);
+		/** operations that could not be aborted still reference the batch */
+		if (batch->inflight > 0)
+			return rc;
+		for (i = 0; i < number; i++)
+			promote_op_reset(&batch->ops[i]);
+		if (rc == 0)
+			rc = batch->rc;
+		if (rc)
+			D_GOTO(out, rc);
+		*nr_copied += number;
+	}
+
+out:
+	for (i = 0; i < nr_ev && !batch->ieq.aborted; i++)
+		daos_event_fini(&batch->ops[i].ev);
+	rc2 = inflight_eq_destroy(&batch->ieq);
+	if (rc == 0)
+		rc = rc2;
+out_free:
+	D_FREE(batch);
+	return rc;
+}
+
+/** Point entry \a name of directory object \a parent_oh to object \a oid */
+static int
+promote_switch_oid(daos_handle_t parent_oh, const char *name, daos_obj_id_t oid)
+{
+	daos_key_t  dkey;
+	daos_iod_t  iod;
+	daos_recx_t recx;
+	d_sg_list_t sgl;
+	d_iov_t     sg_iov;
+	int         rc;
+
+	d_iov_set(&dkey, (void *)name, strlen(name));
+	d_iov_set(&iod.iod_name, INODE_AKEY_NAME, sizeof(INODE_AKEY_NAME) - 1);
+	iod.iod_nr    = 1;
+	iod.iod_size  = 1;
+	recx.rx_idx   = OID_IDX;
+	recx.rx_nr    = sizeof(daos_obj_id_t);
+	iod.iod_recxs = &recx;
+	iod.iod_type  = DAOS_IOD_ARRAY;
+	d_iov_set(&sg_iov, &oid, sizeof(daos_obj_id_t));
+	sgl.sg_nr     = 1;
+	sgl.sg_nr_out = 0;
+	sgl.sg_iovs   = &sg_iov;
+
+	rc = daos_obj_update(parent_oh, DAOS_TX_NONE, DAOS_COND_DKEY_UPDATE, &dkey, 1, &iod, &sgl,
+			     NULL);
+	if (rc) {
+		D_ERROR("Failed to update directory OID: " DF_RC "\n", DP_RC(rc));
+		return daos_der2errno(rc);
+	}
+	return 0;
+}
+
+/** Move directory \a obj to a new object of class \a cid, nothing else may access the container */
+static int
+dir_promote(dfs_t *dfs, dfs_obj_t *obj, daos_oclass_id_t cid)
+{
+	daos_handle_t parent_oh;
+	daos_handle_t new_oh;
+	daos_obj_id_t new_oid;
+	uint64_t      nr_copied;
+	int           rc;
+
+	/** the root OID is recorded in the container properties */
+	if (daos_oid_cmp(obj->oid, dfs->root.oid) == 0)
+		return ENOTSUP;
+
+	/** default to the widest class for directories */
+	if (cid == 0) {
+		rc = dfs_suggest_oclass(dfs, "directory:max", &cid);
+		if (rc)
+			return rc;
+	}
+	if (daos_obj_id2class(obj->oid) == cid)
+		return 0;
+
+	rc = oid_gen(dfs, cid, false, &new_oid);
+	if (rc)
+		return rc;
+
+	rc = daos_obj_open(dfs->coh, new_oid, DAOS_OO_RW, &new_oh, NULL);
+	if (rc) {
+		D_ERROR("daos_obj_open() Failed, " DF_RC "\n", DP_RC(rc));
+		return daos_der2errno(rc);
+	}
+
+	rc = daos_obj_open(dfs->coh, obj->parent_oid, DAOS_OO_RW, &parent_oh, NULL);
+	if (rc) {
+		D_ERROR("daos_obj_open() Failed, " DF_RC "\n", DP_RC(rc));
+		D_GOTO(out_new, rc = daos_der2errno(rc));
+	}
+
+	rc = promote_copy_entries(obj->oh, new_oh, &nr_copied);
+	if (rc)
+		D_GOTO(out_punch, rc);
+
+	rc = promote_switch_oid(parent_oh, obj->name, new_oid);
+	if (rc)
+		D_GOTO(out_punch, rc);
+
+	/** nothing references the old object anymore, failing to punch it only leaks it */
+	rc = daos_obj_punch(obj->oh, DAOS_TX_NONE, 0, NULL);
+	if (rc) {
+		D_WARN("Failed to punch old directory object " DF_OID ", " DF_RC "\n",
+		       DP_OID(obj->oid), DP_RC(rc));
+		rc = 0;
+	}
+
+	D_INFO("Promoted directory %s from " DF_OID " to " DF_OID ", " DF_U64 " entries copied\n",
+	       obj->name, DP_OID(obj->oid), DP_OID(new_oid), nr_copied);
+	D_GOTO(out_parent, rc);
+
+out_punch:
+	/** the directory is not switched, drop the partial copy */
+	daos_obj_punch(new_oh, DAOS_TX_NONE, 0, NULL);
+out_parent:
+	daos_obj_close(parent_oh, NULL);
+out_new:
+	daos_obj_close(new_oh, NULL);
+	return rc;
+}
+
+int
+dfs_dir_promote(daos_handle_t poh, const char *cont, const char *path, daos_oclass_id_t cid)
+{
+	daos_handle_t coh;
+	dfs_t        *dfs;
+	dfs_obj_t    *obj;
+	mode_t        mode;
+	int           rc;
+	int           rc2;
+
+	if (cont == NULL || path == NULL)
+		return EINVAL;
+	if (cid != 0 && !daos_oclass_is_valid(cid))
+		return EINVAL;
+
+	/*
+	 * Other handles would keep creating and removing entries through the old object while it is
+	 * copied, so the container is opened exclusively, which fails while it is open elsewhere.
+	 */
+	rc = daos_cont_open(poh, cont, DAOS_COO_EX, &coh, NULL, NULL);
+	if (rc == -DER_BUSY) {
+		D_ERROR("Container %s is open elsewhere, can't promote %s\n", cont, path);
+		return EBUSY;
+	} else if (rc) {
+		D_ERROR("daos_cont_open() failed: " DF_RC "\n", DP_RC(rc));
+		return daos_der2errno(rc);
+	}
+
+	rc = dfs_mount(poh, coh, O_RDWR, &dfs);
+	if (rc) {
+		D_ERROR("dfs_mount() failed (%d)\n", rc);
+		D_GOTO(out_cont, rc);
+	}
+
+	rc = dfs_lookup(dfs, path, O_RDWR | O_NOFOLLOW, &obj, &mode, NULL);
+	if (rc) {
+		D_ERROR("Failed to look up %s (%d)\n", path, rc);
+		D_GOTO(out_umount, rc);
+	}
+
+	if (S_ISDIR(mode))
+		rc = dir_promote(dfs, obj, cid);
+	else
+		rc = ENOTDIR;
+
+	rc2 = dfs_release(obj);
+	if (rc == 0)
+		rc = rc2;
+out_umount:
+	rc2 = dfs_umount(dfs);
+	if (rc == 0)
+		rc = rc2;
+out_cont:
+	rc2 = daos_cont_close(coh, NULL);
+	if (rc == 0)
+		rc = daos_der2errno(rc2);
+	return rc;
+}
+
 int
 dfs_obj_anchor_split(dfs_obj_t *obj, uint32_t *nr, daos_anchor_t *anchors)
 {
@@ -9,6 +9,7 @@
 #define D_LOGFAC DD_FAC(dfs)
 
 #include <daos/common.h>
+#include <daos/event.h>
 
 #include "dfs_internal.h"
 
@@ -185,3 +186,30 @@ out:
 	D_FREE(enum_buf);
 	return rc;
 }
+
+int
+dfs_dir_list_names(dfs_t *dfs, dfs_obj_t *obj, daos_anchor_t *anchor, uint32_t *nr,
+		   daos_key_desc_t *kds, d_sg_list_t *sgl, daos_event_t *ev)
+{
+	int rc;
+
+	if (dfs == NULL || !dfs->mounted)
+		return EINVAL;
+	if (obj == NULL || !S_ISDIR(obj->mode))
+		return ENOTDIR;
+	if (anchor == NULL || nr == NULL || kds == NULL || sgl == NULL)
+		return EINVAL;
+	if (*nr == 0) {
+		if (ev) {
+			daos_event_launch(ev);
+			daos_event_complete(ev, 0);
+		}
+		return 0;
+	}
+
+	if (ev)
+		daos_event_errno_rc(ev);
+
+	rc = daos_obj_list_dkey(obj->oh, DAOS_TX_NONE, nr, kds, sgl, anchor, ev);
+	return daos_der2errno(rc);
+}
@@ -250,7 +250,8 @@ struct dfuse_obj_hdl {
  * Entries that have been read by dfs_iterate but not passed to the kernel or put in the cache
  * are kept in the drh_dre entries in the readdir handle, as calls progress through the directory
  * then these are processed and added to the reply buffer and put into the cache.  When out of
- * entries in the array a new dfs_iterate call is made to repopulate the array.
+ * entries in the array a new dfs_iterate call is made to repopulate the array, unless the next
+ * entries were already enumerated asynchronously after the previous fetch (see drh_pf).
  *
  * The cache is kept as a list in dfh_cache_list on the readdir handle which is a standard d_list_t
  * however the directory handle also save a pointer to the appropriate entry for that caller.  When
@@ -298,6 +299,8 @@ struct dfuse_readdir_c {
 /* Maximum number of dentries to read at one time. */
 #define READDIR_MAX_COUNT 1024
 
+struct dfuse_readdir_pf;
+
 /* Readdir handle.  Pointed to by any open directory handle after the first readdir call */
 struct dfuse_readdir_hdl {
 	/** an anchor to track listing in readdir */
@@ -311,6 +314,8 @@ struct dfuse_readdir_hdl {
 	uint32_t                   drh_dre_last_index;
 	/** Next value from anchor */
 	uint32_t                   drh_anchor_index;
+	/** Enumeration of the names following drh_dre, started while those are consumed */
+	struct dfuse_readdir_pf   *drh_pf;
 
 	/** List of directory entries read so far, list of dfuse_readdir_c */
 	d_list_t                   drh_cache_list;
@@ -540,6 +545,21 @@ struct dfuse_cont {
 
 	/* Set to true if the inode was allocated to this structure, so should be kept on close*/
 	bool                    dfc_save_ino;
+
+	/** Coherent caching, see inval.c.  Interval at which to poll the container generation,
+	 * zero if disabled.
+	 */
+	double                  dfc_coherent_time;
+	/** Entry on the invalidator list of coherent containers */
+	d_list_t                dfc_ival_entry;
+	/** Set when this container has been modified since the generation was last published */
+	ATOMIC bool             dfc_modified;
+	/** Last generation value seen or published, protected by the invalidator */
+	uint64_t                dfc_generation;
+	/** Time of the next generation poll, protected by the invalidator */
+	struct timespec         dfc_poll_next;
+	/** Dentries last updated before this time are stale, protected by ival_lock */
+	struct timespec         dfc_stale_time;
 };
 
 #define dfs_entry core.dfcc_entry
@@ -550,6 +570,16 @@ struct dfuse_cont {
 #define DFUSE_IE_STAT_ADD(_ie, _stat)                                                              \
 	atomic_fetch_add_relaxed(&(_ie)->ie_dfs->dfs_stat_value[(_stat)], 1)
 
+/* Record that a container is being modified by this node, so that the next generation poll will
+ * publish a new value for other nodes to see.  Only used with coherent caching.
+ */
+#define DFUSE_CONT_MODIFIED(_dfc)                                                                  \
+	do {                                                                                       \
+		if ((_dfc)->dfc_coherent_time != 0 &&                                              \
+		    !atomic_load_relaxed(&(_dfc)->dfc_modified))                                   \
+			atomic_store_relaxed(&(_dfc)->dfc_modified, true);                         \
+	} while (0)
+
 void
 dfuse_set_default_cont_cache_values(struct dfuse_cont *dfc);
 
@@ -406,6 +406,9 @@ _ch_free(struct dfuse_info *dfuse_info, struct dfuse_cont *dfc, bool used)
 		keep         = false;
 	}
 
+	/* Called before closing the container as the invalidator may be using the handle */
+	ival_dec_cont_buckets(dfc);
+
 	if (daos_handle_is_valid(dfc->dfs_coh)) {
 		int rc;
 
@@ -424,8 +427,6 @@ _ch_free(struct dfuse_info *dfuse_info, struct dfuse_cont *dfc, bool used)
 
 	atomic_fetch_sub_relaxed(&dfuse_info->di_container_count, 1);
 
-	ival_dec_cont_buckets(dfc);
-
 	container_stats_log(dfc);
 
 	/* If the container was allocated a fresh inode number or has a open container handle
@@ -560,11 +561,12 @@ dfuse_pool_get_handle(struct dfuse_info *dfuse_info, uuid_t pool, struct dfuse_p
 	return dfuse_pool_connect(dfuse_info, uuid_str, _dfp);
 }
 
-#define ATTR_COUNT 6
+#define ATTR_COUNT 7
 
 char const *const cont_attr_names[ATTR_COUNT] = {
     "dfuse-attr-time",    "dfuse-dentry-time", "dfuse-dentry-dir-time",
-    "dfuse-ndentry-time", "dfuse-data-cache",  "dfuse-direct-io-disable"};
+    "dfuse-ndentry-time", "dfuse-data-cache",  "dfuse-direct-io-disable",
+    "dfuse-coherent"};
 
 #define ATTR_TIME_INDEX              0
 #define ATTR_DENTRY_INDEX            1
@@ -572,6 +574,10 @@ char const *const cont_attr_names[ATTR_COUNT] = {
 #define ATTR_NDENTRY_INDEX           3
 #define ATTR_DATA_CACHE_INDEX        4
 #define ATTR_DIRECT_IO_DISABLE_INDEX 5
+#define ATTR_COHERENT_INDEX          6
+
+/* Generation poll interval used if dfuse-coherent is set to "on" */
+#define COHERENT_DEFAULT_TIME        5
 
 /* Attribute values are of the form "120M", so the buffer does not need to be
  * large.
@@ -697,6 +703,24 @@ dfuse_cont_get_cache(struct dfuse_info *dfuse_info, struct dfuse_cont *dfc)
 			}
 			continue;
 		}
+		if (i == ATTR_COHERENT_INDEX) {
+			if (dfuse_char_enabled(buff_addrs[i], sizes[i])) {
+				dfc->dfc_coherent_time = COHERENT_DEFAULT_TIME;
+				DFUSE_TRA_INFO(dfc, "setting '%s' is enabled", cont_attr_names[i]);
+			} else if (dfuse_char_disabled(buff_addrs[i], sizes[i])) {
+				dfc->dfc_coherent_time = 0;
+				DFUSE_TRA_INFO(dfc, "setting '%s' is disabled", cont_attr_names[i]);
+			} else if (dfuse_parse_time(buff_addrs[i], sizes[i], &value) == 0) {
+				DFUSE_TRA_INFO(dfc, "setting '%s' is %u seconds",
+					       cont_attr_names[i], value);
+				dfc->dfc_coherent_time = value;
+			} else {
+				DFUSE_TRA_WARNING(dfc, "Failed to parse '%s' for '%s'",
+						  buff_addrs[i], cont_attr_names[i]);
+				dfc->dfc_coherent_time = 0;
+			}
+			continue;
+		}
 
 		rc = dfuse_parse_time(buff_addrs[i], sizes[i], &value);
 		if (rc != 0) {
@@ -117,6 +117,7 @@ df_ll_create(fuse_req_t req, fuse_ino_t parent, const char *name, mode_t mode,
 		D_GOTO(err, rc = ENOTSUP);
 
 	DFUSE_IE_STAT_ADD(parent_inode, DS_CREATE);
+	DFUSE_CONT_MODIFIED(parent_inode->ie_dfs);
 
 	parent_inode->ie_dfs->dfs_ops->create(req, parent_inode, name, mode, fi);
 
@@ -138,6 +139,7 @@ df_ll_mknod(fuse_req_t req, fuse_ino_t parent, const char *name, mode_t mode, de
 		D_GOTO(err, rc = ENOTSUP);
 
 	DFUSE_IE_STAT_ADD(parent_inode, DS_MKNOD);
+	DFUSE_CONT_MODIFIED(parent_inode->ie_dfs);
 
 	parent_inode->ie_dfs->dfs_ops->mknod(req, parent_inode, name, mode);
 
@@ -204,6 +206,7 @@ df_ll_setattr(fuse_req_t req, fuse_ino_t ino, struct stat *attr, int to_set,
 		inode = dfuse_inode_lookup_nf(dfuse_info, ino);
 		DFUSE_IE_STAT_ADD(inode, DS_SETATTR);
 	}
+	DFUSE_CONT_MODIFIED(inode->ie_dfs);
 
 	DFUSE_IE_WFLUSH(inode);
 
@@ -243,6 +246,7 @@ df_ll_mkdir(fuse_req_t req, fuse_ino_t parent, const char *name, mode_t mode)
 		D_GOTO(err, rc = ENOTSUP);
 
 	DFUSE_IE_STAT_ADD(parent_inode, DS_MKDIR);
+	DFUSE_CONT_MODIFIED(parent_inode->ie_dfs);
 
 	parent_inode->ie_dfs->dfs_ops->mknod(req, parent_inode, name, mode | S_IFDIR);
 
@@ -305,6 +309,7 @@ df_ll_unlink(fuse_req_t req, fuse_ino_t parent, const char *name)
 		D_GOTO(err, rc = ENOTSUP);
 
 	DFUSE_IE_STAT_ADD(parent_inode, DS_UNLINK);
+	DFUSE_CONT_MODIFIED(parent_inode->ie_dfs);
 
 	parent_inode->ie_dfs->dfs_ops->unlink(req, parent_inode, name);
 
@@ -365,6 +370,7 @@ df_ll_symlink(fuse_req_t req, const char *link, fuse_ino_t parent, const char *n
 		D_GOTO(err, rc = ENOTSUP);
 
 	DFUSE_IE_STAT_ADD(parent_inode, DS_SYMLINK);
+	DFUSE_CONT_MODIFIED(parent_inode->ie_dfs);
 
 	parent_inode->ie_dfs->dfs_ops->symlink(req, link, parent_inode, name);
 
@@ -403,6 +409,7 @@ df_ll_setxattr(fuse_req_t req, fuse_ino_t ino, const char *name, const char *val
 		D_GOTO(err, rc = ENOTSUP);
 
 	DFUSE_IE_STAT_ADD(inode, DS_SETXATTR);
+	DFUSE_CONT_MODIFIED(inode->ie_dfs);
 
 	inode->ie_dfs->dfs_ops->setxattr(req, inode, name, value, size, flags);
 
@@ -459,6 +466,7 @@ df_ll_removexattr(fuse_req_t req, fuse_ino_t ino, const char *name)
 		D_GOTO(err, rc = ENOTSUP);
 
 	DFUSE_IE_STAT_ADD(inode, DS_RMXATTR);
+	DFUSE_CONT_MODIFIED(inode->ie_dfs);
 
 	inode->ie_dfs->dfs_ops->removexattr(req, inode, name);
 
@@ -500,6 +508,7 @@ df_ll_rename(fuse_req_t req, fuse_ino_t parent, const char *name, fuse_ino_t new
 	parent_inode = dfuse_inode_lookup_nf(dfuse_info, parent);
 
 	DFUSE_IE_STAT_ADD(parent_inode, DS_RENAME);
+	DFUSE_CONT_MODIFIED(parent_inode->ie_dfs);
 
 	if (!parent_inode->ie_dfs->dfs_ops->rename)
 		D_GOTO(err, rc = EXDEV);
@@ -451,6 +451,31 @@ ioil_get_eqh(daos_handle_t *eqh)
 	return 0;
 }
 
+int
+ioil_iov2diov(const struct iovec *iov, int count, d_iov_t *diov, size_t *total)
+{
+	int nr = 0;
+	int i;
+
+	*total = 0;
+	for (i = 0; i < count; i++) {
+		/** See DAOS-15089. This is a workaround */
+		if (iov[i].iov_len == 0)
+			continue;
+		*total += iov[i].iov_len;
+
+		/** merge with the previous segment if the buffers are adjacent in memory */
+		if (nr > 0 &&
+		    (char *)diov[nr - 1].iov_buf + diov[nr - 1].iov_len == (char *)iov[i].iov_base) {
+			diov[nr - 1].iov_len += iov[i].iov_len;
+			diov[nr - 1].iov_buf_len += iov[i].iov_len;
+			continue;
+		}
+		d_iov_set(&diov[nr++], iov[i].iov_base, iov[i].iov_len);
+	}
+	return nr;
+}
+
 /* Get the object handle for the file itself */
 static int
 fetch_dfs_obj_handle(int fd, struct fd_entry *entry)
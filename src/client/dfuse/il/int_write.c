@@ -79,33 +79,27 @@ ssize_t
 ioil_do_pwritev(const struct iovec *iov, int count, off_t position, struct fd_entry *entry,
 		int *errcode)
 {
-	d_iov_t    *diov;
-	d_sg_list_t sgl         = {};
-	size_t      total_write = 0;
-	int         i;
-	int         rc;
-	int         new_count;
-
-	D_ALLOC_ARRAY(diov, count);
-	if (diov == NULL) {
-		*errcode = ENOMEM;
-		return -1;
-	}
-
-	for (i = 0, new_count = 0; i < count; i++) {
-		/** See DAOS-15089. This is a workaround */
-		if (iov[i].iov_len == 0)
-			continue;
-		d_iov_set(&diov[new_count++], iov[i].iov_base, iov[i].iov_len);
-		total_write += iov[i].iov_len;
+	d_iov_t     diov_inline[IOIL_IOV_INLINE];
+	d_iov_t    *diov = diov_inline;
+	d_sg_list_t sgl  = {};
+	size_t      total_write;
+	ssize_t     rc;
+
+	if (count > IOIL_IOV_INLINE) {
+		D_ALLOC_ARRAY(diov, count);
+		if (diov == NULL) {
+			*errcode = ENOMEM;
+			return -1;
+		}
 	}
 
-	sgl.sg_nr   = new_count;
+	sgl.sg_nr   = ioil_iov2diov(iov, count, diov, &total_write);
 	sgl.sg_iovs = diov;
 
 	rc = ioil_do_writesgl(&sgl, total_write, position, entry, errcode);
 
-	D_FREE(diov);
+	if (diov != diov_inline)
+		D_FREE(diov);
 
 	return rc;
 }
@@ -56,4 +56,14 @@ ioil_do_pwritev(const struct iovec *iov, int count, off_t position, struct fd_en
 int
 ioil_get_eqh(daos_handle_t *eqh);
 
+/* Number of iovecs of a vectored I/O handled without a heap allocation */
+#define IOIL_IOV_INLINE 8
+
+/*
+ * Fill diov (which must have room for count entries) from iov, skipping empty entries and
+ * merging entries that are adjacent in memory. Returns the number of entries used.
+ */
+int
+ioil_iov2diov(const struct iovec *iov, int count, d_iov_t *diov, size_t *total);
+
 #endif /* __IOIL_H__ */
@@ -69,6 +69,20 @@
  * but at least 2 seconds and at most 60.
  * As this relates to releasing resources there is no additional benefit in finer grained time
  * control than this.
+ *
+ * Coherent caching: Containers with the dfuse-coherent attribute set keep a "dfuse-generation"
+ * container attribute which any dfuse instance modifying the container will change, at most once
+ * per poll interval.  The invalidation thread polls the generation of each such container and
+ * when it changes because of another node marks every dentry cached for the container before that
+ * point as stale, these are then evicted from the kernel as if they had timed out, open files have
+ * their dentry and inode invalidated instead and stay on their list.  This allows
+ * long cache timeouts to be used on datasets which change rarely whilst still seeing updates from
+ * other nodes within a few seconds.  DAOS has no way of sending callbacks from the server so this
+ * is the nearest equivalent, it costs one RPC per container per interval regardless of the number
+ * of cached entries.  Negative dentries are not tracked so still rely on dfuse-ndentry-time, and
+ * writes which bypass dfuse (such as from the interception library) do not change the generation.
+ * The attribute is updated by read-then-write so two nodes publishing concurrently may miss each
+ * others update, in which case the regular timeouts still apply.
  */
 
 /* Grace period before invalidating directories or non-directories.  Needs to be long enough so that
@@ -89,9 +103,18 @@ struct dfuse_time_entry {
 
 /* Core data structure, maintains a list of struct dfuse_time_entry lists */
 struct dfuse_ival {
-	d_list_t             time_entry_list;
-	struct fuse_session *session;
-	bool                 session_dead;
+	d_list_t                 time_entry_list;
+	/* Containers using coherent caching, protected by ival_cont_lock */
+	d_list_t                 cont_list;
+	struct fuse_session     *session;
+	bool                     session_dead;
+	/* Set when a container generation has changed and stale entries need evicting */
+	bool                     inval_pending;
+	/* Position of the stale walk, the list being walked and the next inode to check in it, or
+	 * NULL to start at the first list or at the start of the list.
+	 */
+	struct dfuse_time_entry *stale_dte;
+	d_list_t                *stale_pos;
 };
 
 /* The core data from struct dfuse_inode_entry.  No additional inode references are held on inodes
@@ -103,6 +126,8 @@ struct dfuse_ival {
 struct inode_core {
 	char       name[NAME_MAX + 1];
 	fuse_ino_t parent;
+	/* Set for open inodes whose attributes and data are invalidated as well as the dentry */
+	fuse_ino_t ino;
 };
 
 /* Number of dentries to invalidate per iteration. This value affects how long the lock is held,
@@ -112,12 +137,111 @@ struct inode_core {
  */
 #define EVICT_COUNT 8
 
-static pthread_mutex_t   ival_lock = PTHREAD_MUTEX_INITIALIZER;
+/* Name of the container attribute used for coherent caching, and the size of its value */
+#define IVAL_GENERATION_ATTR "dfuse-generation"
+#define IVAL_GENERATION_LEN  32
+
+static pthread_mutex_t   ival_lock      = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t   ival_cont_lock = PTHREAD_MUTEX_INITIALIZER;
 static bool              ival_stop;
 static pthread_t         ival_thread;
 static sem_t             ival_sem;
 static struct dfuse_ival ival_data;
 
+/* Returns true if the dentry for an inode was cached before its container generation changed.
+ * Called with ival_lock held.
+ */
+static bool
+ival_inode_stale(struct dfuse_inode_entry *inode)
+{
+	struct timespec *stale = &inode->ie_dfs->dfc_stale_time;
+	struct timespec *last  = &inode->ie_dentry_last_update;
+
+	if (inode->ie_dfs->dfc_coherent_time == 0 || stale->tv_sec == 0)
+		return false;
+
+	if (last->tv_sec != stale->tv_sec)
+		return last->tv_sec < stale->tv_sec;
+	return last->tv_nsec <= stale->tv_nsec;
+}
+
+/* Called with ival_lock held before an inode is removed from or moved between lists so that the
+ * stale walk does not resume from it.
+ */
+static void
+ival_stale_skip(struct dfuse_inode_entry *inode)
+{
+	if (ival_data.stale_pos == &inode->ie_evict_entry)
+		ival_data.stale_pos = inode->ie_evict_entry.next;
+}
+
+/* Walk every list looking for stale entries from coherent containers, resuming from where the
+ * previous call stopped.  Called with ival_lock held.
+ *
+ * Returns true if the walk completed, false if ic was filled first.
+ */
+static bool
+ival_stale_walk(struct inode_core *ic, int *idx)
+{
+	struct dfuse_time_entry *dte = ival_data.stale_dte;
+	d_list_t                *pos = ival_data.stale_pos;
+
+	if (dte == NULL) {
+		if (d_list_empty(&ival_data.time_entry_list))
+			return true;
+		dte = d_list_entry(ival_data.time_entry_list.next, struct dfuse_time_entry, dte_list);
+		pos = NULL;
+	}
+
+	while (*idx < EVICT_COUNT) {
+		struct dfuse_inode_entry *inode;
+
+		if (pos == NULL)
+			pos = dte->inode_list.next;
+
+		if (pos == &dte->inode_list) {
+			if (dte->dte_list.next == &ival_data.time_entry_list) {
+				ival_data.stale_dte = NULL;
+				ival_data.stale_pos = NULL;
+				return true;
+			}
+			dte = d_list_entry(dte->dte_list.next, struct dfuse_time_entry, dte_list);
+			pos = NULL;
+			continue;
+		}
+
+		inode = d_list_entry(pos, struct dfuse_inode_entry, ie_evict_entry);
+		pos   = pos->next;
+
+		if (!ival_inode_stale(inode))
+			continue;
+
+		DFUSE_TRA_DEBUG(inode, "Generation changed " DF_DE, DP_DE(inode->ie_name));
+
+		dfuse_cache_evict(inode);
+
+		ic[*idx].parent = inode->ie_parent;
+		strncpy(ic[*idx].name, inode->ie_name, NAME_MAX + 1);
+		ic[*idx].name[NAME_MAX] = '\0';
+
+		/* Open files cannot be evicted so have the kernel drop any cached attributes and data
+		 * as well as the dentry, and keep them on the list so that they still time out.
+		 */
+		if (atomic_load_relaxed(&inode->ie_open_count) != 0) {
+			ic[*idx].ino = inode->ie_stat.st_ino;
+		} else {
+			ic[*idx].ino = 0;
+			d_list_del_init(&inode->ie_evict_entry);
+		}
+
+		(*idx)++;
+	}
+
+	ival_data.stale_dte = dte;
+	ival_data.stale_pos = pos;
+	return false;
+}
+
 /* Eviction loop, run periodically in it's own thread
  *
  * Returns true if there is more work to do.  If false then *sleep_time is set in seconds.
@@ -132,6 +256,12 @@ ival_loop(int *sleep_time)
 
 	D_MUTEX_LOCK(&ival_lock);
 
+	if (ival_data.inval_pending) {
+		if (!ival_stale_walk(ic, &idx))
+			goto out;
+		ival_data.inval_pending = false;
+	}
+
 	/* Walk the list, oldest first */
 	d_list_for_each_entry_safe(dte, dtep, &ival_data.time_entry_list, dte_list) {
 		struct dfuse_inode_entry *inode, *inodep;
@@ -139,6 +269,12 @@ ival_loop(int *sleep_time)
 		DFUSE_TRA_DEBUG(dte, "Iterating for timeout %.1lf ref %d", dte->time, dte->ref);
 
 		if (dte->ref == 0 && d_list_empty(&dte->inode_list)) {
+			/* The stale walk is past every other list if it is on this one */
+			if (dte == ival_data.stale_dte) {
+				ival_data.stale_dte     = NULL;
+				ival_data.stale_pos     = NULL;
+				ival_data.inval_pending = false;
+			}
 			d_list_del(&dte->dte_list);
 			D_FREE(dte);
 			continue;
@@ -165,6 +301,7 @@ ival_loop(int *sleep_time)
 			strncpy(ic[idx].name, inode->ie_name, NAME_MAX + 1);
 			ic[idx].name[NAME_MAX] = '\0';
 
+			ival_stale_skip(inode);
 			d_list_del_init(&inode->ie_evict_entry);
 
 			idx++;
@@ -185,6 +322,18 @@ out:
 	for (int i = 0; i < idx; i++) {
 		int rc;
 
+		if (ic[i].ino != 0) {
+			DFUSE_TRA_DEBUG(&ival_data, "Invalidating inode %#lx", ic[i].ino);
+
+			rc = fuse_lowlevel_notify_inval_inode(ival_data.session, ic[i].ino, 0, 0);
+			if (rc && rc != -ENOENT && rc != -EBADF)
+				DHS_ERROR(&ival_data, -rc, "notify_inval_inode() failed");
+			if (rc == -EBADF) {
+				ival_data.session_dead = true;
+				continue;
+			}
+		}
+
 		DFUSE_TRA_DEBUG(&ival_data, "Evicting entry %#lx " DF_DE, ic[i].parent,
 				DP_DE(ic[i].name));
 
@@ -199,6 +348,143 @@ out:
 	return (idx == EVICT_COUNT);
 }
 
+/* Read the current generation of a container, a container without one is at generation zero.
+ *
+ * Returns a system error code.
+ */
+static int
+ival_generation_fetch(struct dfuse_cont *dfc, uint64_t *gen)
+{
+	char        buff[IVAL_GENERATION_LEN] = {};
+	char const *name                      = IVAL_GENERATION_ATTR;
+	void       *value                     = buff;
+	size_t      size                      = sizeof(buff) - 1;
+	int         rc;
+
+	rc = daos_cont_get_attr(dfc->dfs_coh, 1, &name, &value, &size, NULL);
+	if (rc == -DER_NONEXIST) {
+		*gen = 0;
+		return 0;
+	}
+	if (rc != -DER_SUCCESS)
+		return daos_der2errno(rc);
+
+	*gen = strtoull(buff, NULL, 16);
+	return 0;
+}
+
+/* Publish a new generation for a container, chosen at random so that it will differ from any
+ * other node publishing at the same time.
+ *
+ * Returns a system error code.
+ */
+static int
+ival_generation_publish(struct dfuse_cont *dfc, uint64_t *gen)
+{
+	char        buff[IVAL_GENERATION_LEN];
+	char const *name  = IVAL_GENERATION_ATTR;
+	void const *value = buff;
+	size_t      size;
+	uint64_t    next;
+	int         rc;
+
+	do {
+		next = ((uint64_t)d_rand() << 32) ^ (uint64_t)d_rand();
+	} while (next == 0 || next == *gen);
+
+	size = snprintf(buff, sizeof(buff), "%#" PRIx64, next);
+
+	rc = daos_cont_set_attr(dfc->dfs_coh, 1, &name, &value, &size, NULL);
+	if (rc != -DER_SUCCESS)
+		return daos_der2errno(rc);
+
+	*gen = next;
+	return 0;
+}
+
+/* Poll one coherent container, publishing a new generation if modified locally and marking
+ * cached entries stale if it has been modified elsewhere.  Called with ival_cont_lock held.
+ */
+static void
+ival_poll_cont(struct dfuse_cont *dfc, struct timespec *now)
+{
+	uint64_t gen;
+	bool     modified;
+	int      rc;
+
+	modified = atomic_exchange(&dfc->dfc_modified, false);
+
+	rc = ival_generation_fetch(dfc, &gen);
+	if (rc != 0) {
+		DHS_WARN(dfc, rc, "Failed to read container generation");
+		goto err;
+	}
+
+	if (gen != dfc->dfc_generation) {
+		DFUSE_TRA_INFO(dfc, "Container generation changed " DF_X64 " -> " DF_X64,
+			       dfc->dfc_generation, gen);
+
+		/* Restart any walk in progress as entries it went past may be stale now */
+		D_MUTEX_LOCK(&ival_lock);
+		dfc->dfc_stale_time     = *now;
+		ival_data.inval_pending = true;
+		ival_data.stale_dte     = NULL;
+		ival_data.stale_pos     = NULL;
+		D_MUTEX_UNLOCK(&ival_lock);
+	}
+
+	if (modified) {
+		rc = ival_generation_publish(dfc, &gen);
+		if (rc != 0) {
+			DHS_WARN(dfc, rc, "Failed to publish container generation");
+			dfc->dfc_generation = gen;
+			goto err;
+		}
+		DFUSE_TRA_DEBUG(dfc, "Published generation " DF_X64, gen);
+	}
+
+	dfc->dfc_generation = gen;
+	return;
+err:
+	/* Retry publishing on the next poll */
+	if (modified)
+		atomic_store_relaxed(&dfc->dfc_modified, true);
+}
+
+/* Poll every coherent container which is due.
+ *
+ * Returns the time in seconds until the next poll is needed.
+ */
+static double
+ival_poll(void)
+{
+	struct dfuse_cont *dfc;
+	struct timespec    now;
+	double             sleep = 60;
+
+	D_MUTEX_LOCK(&ival_cont_lock);
+	d_list_for_each_entry(dfc, &ival_data.cont_list, dfc_ival_entry) {
+		double left;
+
+		clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+
+		left = (dfc->dfc_poll_next.tv_sec - now.tv_sec) +
+		       (double)(dfc->dfc_poll_next.tv_nsec - now.tv_nsec) / 1000000000;
+		if (left <= 0) {
+			ival_poll_cont(dfc, &now);
+
+			dfc->dfc_poll_next = now;
+			dfc->dfc_poll_next.tv_sec += (time_t)dfc->dfc_coherent_time;
+			left = dfc->dfc_coherent_time;
+		}
+		if (left < sleep)
+			sleep = left;
+	}
+	D_MUTEX_UNLOCK(&ival_cont_lock);
+
+	return sleep;
+}
+
 /* Main loop for eviction thread.  Spins until ready for exit waking after one second and iterates
  * over all newly expired dentries.
  */
@@ -209,6 +495,7 @@ ival_thread_fn(void *arg)
 
 	while (1) {
 		struct timespec ts = {};
+		double          poll_time;
 		int             rc;
 
 		if (clock_gettime(CLOCK_REALTIME, &ts) == -1)
@@ -226,8 +513,12 @@ ival_thread_fn(void *arg)
 				DS_ERROR(rc, "sem_wait");
 		}
 
+		poll_time = ival_poll();
+
 		while (ival_loop(&sleep_time))
 			;
+		if (sleep_time > poll_time)
+			sleep_time = (int)ceil(poll_time);
 		if (sleep_time < 2)
 			sleep_time = 2;
 		DFUSE_TRA_DEBUG(&ival_data, "Sleeping %d", sleep_time);
@@ -266,6 +557,7 @@ ival_init(struct dfuse_info *dfuse_info)
 	DFUSE_TRA_UP(&ival_data, dfuse_info, "invalidator");
 
 	D_INIT_LIST_HEAD(&ival_data.time_entry_list);
+	D_INIT_LIST_HEAD(&ival_data.cont_list);
 
 	rc = sem_init(&ival_sem, 0, 0);
 	if (rc != 0)
@@ -369,6 +661,7 @@ ival_update_inode(struct dfuse_inode_entry *inode, double timeout)
 		DFUSE_TRA_DEBUG(inode, "timeout %.1lf wake:" DF_BOOL " %#lx " DF_DE, timeout,
 				DP_BOOL(wake), inode->ie_parent, DP_DE(inode->ie_name));
 
+		ival_stale_skip(inode);
 		d_list_move_tail(&inode->ie_evict_entry, &dte->inode_list);
 		break;
 	}
@@ -443,6 +736,32 @@ ival_bucket_dec_value(double timeout)
 	DFUSE_TRA_ERROR(&ival_data, "Unable to find ref for %.1lf", timeout);
 }
 
+/* Start polling the generation of a coherent container, reading the current value first so that
+ * entries are only invalidated by changes made after the container was opened.
+ */
+static void
+ival_add_cont_coherent(struct dfuse_cont *dfc)
+{
+	int rc;
+
+	rc = ival_generation_fetch(dfc, &dfc->dfc_generation);
+	if (rc != 0) {
+		DHS_WARN(dfc, rc, "Failed to read container generation, coherent caching disabled");
+		dfc->dfc_coherent_time = 0;
+		return;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC_COARSE, &dfc->dfc_poll_next);
+	dfc->dfc_poll_next.tv_sec += (time_t)dfc->dfc_coherent_time;
+
+	D_MUTEX_LOCK(&ival_cont_lock);
+	d_list_add_tail(&dfc->dfc_ival_entry, &ival_data.cont_list);
+	D_MUTEX_UNLOCK(&ival_cont_lock);
+
+	/* Wake the thread so it can shorten its sleep to the poll interval */
+	sem_post(&ival_sem);
+}
+
 /* Ensure the correct buckets exist for a attached container.  Pools have a zero dentry timeout
  * so skip zero values
  */
@@ -465,12 +784,22 @@ ival_add_cont_buckets(struct dfuse_cont *dfc)
 out:
 	D_MUTEX_UNLOCK(&ival_lock);
 
+	if (rc == 0 && dfc->dfc_coherent_time != 0)
+		ival_add_cont_coherent(dfc);
+
 	return rc;
 }
 
 void
 ival_dec_cont_buckets(struct dfuse_cont *dfc)
 {
+	/* Waits for any poll of this container in progress */
+	if (dfc->dfc_coherent_time != 0) {
+		D_MUTEX_LOCK(&ival_cont_lock);
+		d_list_del(&dfc->dfc_ival_entry);
+		D_MUTEX_UNLOCK(&ival_cont_lock);
+	}
+
 	D_MUTEX_LOCK(&ival_lock);
 	if (dfc->dfc_dentry_timeout != 0)
 		ival_bucket_dec_value(dfc->dfc_dentry_timeout + INVAL_FILE_GRACE);
@@ -483,7 +812,9 @@ void
 ival_drop_inode(struct dfuse_inode_entry *ie)
 {
 	D_MUTEX_LOCK(&ival_lock);
-	if (!d_list_empty(&ie->ie_evict_entry))
+	if (!d_list_empty(&ie->ie_evict_entry)) {
+		ival_stale_skip(ie);
 		d_list_del(&ie->ie_evict_entry);
+	}
 	D_MUTEX_UNLOCK(&ival_lock);
 }
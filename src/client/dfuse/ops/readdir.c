@@ -20,6 +20,9 @@
 /* Offset of the first file, allow two entries for . and .. */
 #define OFFSET_BASE        2
 
+/* Number of dentries to prefetch while the kernel consumes the current ones */
+#define READDIR_PF_COUNT   256
+
 struct iterate_data {
 	off_t                     id_base_offset;
 	int                       id_index;
@@ -67,12 +70,163 @@ filler_cb(dfs_t *dfs, dfs_obj_t *dir, const char name[], void *arg)
 	return 0;
 }
 
+/* Prefetch of the dentries following the ones in drh_dre.  The names are enumerated on a dfuse
+ * event queue while the kernel consumes the current entries so that the next readdir call does
+ * not have to wait for a round trip.  The prefetch starts from a copy of the handle anchor which
+ * is only replaced when the result is consumed, so discarding a prefetch, for example on seek,
+ * leaves the handle untouched.
+ */
+struct dfuse_readdir_pf {
+	struct dfuse_event rp_ev;
+	sem_t              rp_sem;
+	/* Launched and neither consumed nor discarded yet */
+	bool               rp_pending;
+	int                rp_rc;
+	uint32_t           rp_nr;
+	daos_anchor_t      rp_anchor;
+	daos_key_desc_t    rp_kds[READDIR_PF_COUNT];
+	char               rp_buf[READDIR_PF_COUNT * (NAME_MAX + 1)];
+};
+
+static void
+readdir_pf_complete(struct dfuse_event *ev)
+{
+	struct dfuse_readdir_pf *pf = container_of(ev, struct dfuse_readdir_pf, rp_ev);
+
+	pf->rp_rc = ev->de_ev.ev_error;
+	sem_post(&pf->rp_sem);
+}
+
+/* Wait for a pending prefetch to complete, the result is then owned by the caller */
+static void
+readdir_pf_wait(struct dfuse_readdir_pf *pf)
+{
+	D_ASSERT(pf->rp_pending);
+
+	while (sem_wait(&pf->rp_sem) != 0 && errno == EINTR)
+		;
+	daos_event_fini(&pf->rp_ev.de_ev);
+	pf->rp_pending = false;
+}
+
+static void
+readdir_pf_discard(struct dfuse_readdir_pf *pf)
+{
+	if (pf != NULL && pf->rp_pending)
+		readdir_pf_wait(pf);
+}
+
+static void
+readdir_pf_free(struct dfuse_readdir_pf *pf)
+{
+	if (pf == NULL)
+		return;
+
+	readdir_pf_discard(pf);
+	sem_destroy(&pf->rp_sem);
+	D_FREE(pf);
+}
+
+/* Start enumerating the dentries following the current anchor of the handle.  This is only an
+ * optimization so failures are not reported, the next fetch will be synchronous instead.
+ */
+static void
+readdir_pf_start(struct dfuse_info *dfuse_info, struct dfuse_obj_hdl *oh)
+{
+	struct dfuse_readdir_hdl *hdl = oh->doh_rd;
+	struct dfuse_readdir_pf  *pf  = hdl->drh_pf;
+	int                       rc;
+
+	if (daos_anchor_is_eof(&hdl->drh_anchor))
+		return;
+
+	if (pf == NULL) {
+		uint64_t eqt_idx;
+
+		D_ALLOC_PTR(pf);
+		if (pf == NULL)
+			return;
+
+		rc = sem_init(&pf->rp_sem, 0, 0);
+		if (rc != 0) {
+			D_FREE(pf);
+			return;
+		}
+
+		eqt_idx                  = atomic_fetch_add_relaxed(&dfuse_info->di_eqt_idx, 1);
+		pf->rp_ev.de_eqt         = &dfuse_info->di_eqt[eqt_idx % dfuse_info->di_eq_count];
+		pf->rp_ev.de_complete_cb = readdir_pf_complete;
+		pf->rp_ev.de_sgl.sg_iovs = &pf->rp_ev.de_iov;
+		pf->rp_ev.de_sgl.sg_nr   = 1;
+		hdl->drh_pf              = pf;
+	}
+	D_ASSERT(!pf->rp_pending);
+
+	rc = daos_event_init(&pf->rp_ev.de_ev, pf->rp_ev.de_eqt->de_eq, NULL);
+	if (rc != -DER_SUCCESS)
+		return;
+
+	pf->rp_anchor = hdl->drh_anchor;
+	pf->rp_nr     = READDIR_PF_COUNT;
+	d_iov_set(&pf->rp_ev.de_iov, pf->rp_buf, sizeof(pf->rp_buf));
+	pf->rp_ev.de_sgl.sg_nr_out = 0;
+
+	rc = dfs_dir_list_names(oh->doh_dfs, oh->doh_ie->ie_obj, &pf->rp_anchor, &pf->rp_nr,
+				pf->rp_kds, &pf->rp_ev.de_sgl, &pf->rp_ev.de_ev);
+	if (rc != 0) {
+		DFUSE_TRA_DEBUG(hdl, "Failed to start prefetch: %d (%s)", rc, strerror(rc));
+		daos_event_fini(&pf->rp_ev.de_ev);
+		return;
+	}
+
+	pf->rp_pending = true;
+	sem_post(&pf->rp_ev.de_eqt->de_sem);
+}
+
+/* Populate drh_dre from a pending prefetch.  Returns false if there is none or it cannot be used,
+ * in which case the entries should be fetched synchronously.
+ */
+static bool
+readdir_pf_take(struct dfuse_readdir_hdl *hdl, off_t offset, uint32_t *count)
+{
+	struct dfuse_readdir_pf *pf = hdl->drh_pf;
+	char                    *ptr;
+	uint32_t                 i;
+
+	if (pf == NULL || !pf->rp_pending)
+		return false;
+
+	readdir_pf_wait(pf);
+
+	/* An enumeration can come back empty before the end of the directory */
+	if (pf->rp_rc != 0 || (pf->rp_nr == 0 && !daos_anchor_is_eof(&pf->rp_anchor))) {
+		DFUSE_TRA_DEBUG(hdl, "Not using prefetch, rc %d nr %d", pf->rp_rc, pf->rp_nr);
+		return false;
+	}
+
+	for (ptr = pf->rp_buf, i = 0; i < pf->rp_nr; i++) {
+		struct dfuse_readdir_entry *dre = &hdl->drh_dre[i];
+		size_t                      len = min(pf->rp_kds[i].kd_key_len, NAME_MAX);
+
+		memcpy(dre->dre_name, ptr, len);
+		dre->dre_name[len]   = '\0';
+		dre->dre_offset      = offset + i;
+		dre->dre_next_offset = dre->dre_offset + 1;
+		ptr += pf->rp_kds[i].kd_key_len;
+	}
+
+	hdl->drh_anchor = pf->rp_anchor;
+	*count          = pf->rp_nr;
+	return true;
+}
+
 static int
-fetch_dir_entries(struct dfuse_obj_hdl *oh, off_t offset, int to_fetch, bool *eod)
+fetch_dir_entries(struct dfuse_info *dfuse_info, struct dfuse_obj_hdl *oh, off_t offset,
+		  int to_fetch, bool *eod)
 {
 	struct iterate_data       idata = {};
 	uint32_t                  count = to_fetch;
-	int                       rc;
+	int                       rc    = 0;
 	struct dfuse_readdir_hdl *hdl = oh->doh_rd;
 
 	idata.id_base_offset = offset;
@@ -82,12 +236,16 @@ fetch_dir_entries(struct dfuse_obj_hdl *oh, off_t offset, int to_fetch, bool *eo
 
 	D_ASSERT(oh->doh_rd);
 
-	rc = dfs_iterate(oh->doh_dfs, oh->doh_ie->ie_obj, &hdl->drh_anchor, &count,
-			 (NAME_MAX + 1) * count, filler_cb, &idata);
-
-	if (rc) {
-		DFUSE_TRA_ERROR(oh, "dfs_iterate() returned: %d (%s)", rc, strerror(rc));
-		return rc;
+	if (readdir_pf_take(hdl, offset, &count)) {
+		DFUSE_TRA_DEBUG(hdl, "Using %d prefetched entries", count);
+	} else {
+		count = to_fetch;
+		rc    = dfs_iterate(oh->doh_dfs, oh->doh_ie->ie_obj, &hdl->drh_anchor, &count,
+				    (NAME_MAX + 1) * count, filler_cb, &idata);
+		if (rc) {
+			DFUSE_TRA_ERROR(oh, "dfs_iterate() returned: %d (%s)", rc, strerror(rc));
+			return rc;
+		}
 	}
 
 	hdl->drh_anchor_index += count;
@@ -104,6 +262,9 @@ fetch_dir_entries(struct dfuse_obj_hdl *oh, off_t offset, int to_fetch, bool *eo
 		*eod = true;
 	}
 
+	/* Enumerate the next entries while these ones are consumed */
+	readdir_pf_start(dfuse_info, oh);
+
 	return rc;
 }
 
@@ -132,6 +293,7 @@ dfuse_dre_drop(struct dfuse_info *dfuse_info, struct dfuse_obj_hdl *oh)
 {
 	struct dfuse_readdir_hdl *hdl;
 	struct dfuse_readdir_c   *drc, *next;
+	struct dfuse_readdir_pf  *pf = NULL;
 	uint32_t                  oldref;
 	off_t                     next_offset = 0;
 
@@ -170,9 +332,13 @@ dfuse_dre_drop(struct dfuse_info *dfuse_info, struct dfuse_obj_hdl *oh)
 			d_hash_rec_decref(&dfuse_info->dpi_iet, drc->drc_rlink);
 		D_FREE(drc);
 	}
+	pf = hdl->drh_pf;
 	D_FREE(hdl);
 unlock:
 	D_SPIN_UNLOCK(&dfuse_info->di_lock);
+
+	/* A prefetch only references its own buffers so wait for it outside of the lock */
+	readdir_pf_free(pf);
 }
 
 static int
@@ -281,6 +447,7 @@ set_entry_params(struct fuse_entry_param *entry, struct dfuse_inode_entry *ie)
 static inline void
 dfuse_readdir_reset(struct dfuse_readdir_hdl *hdl)
 {
+	readdir_pf_discard(hdl->drh_pf);
 	memset(&hdl->drh_anchor, 0, sizeof(hdl->drh_anchor));
 	memset(hdl->drh_dre, 0, sizeof(*hdl->drh_dre) * READDIR_MAX_COUNT);
 	hdl->drh_dre_index      = 0;
@@ -635,7 +802,7 @@ restart:
 			else
 				to_fetch = READDIR_BASE_COUNT - added;
 
-			rc = fetch_dir_entries(oh, offset, to_fetch, &eod);
+			rc = fetch_dir_entries(dfuse_info, oh, offset, to_fetch, &eod);
 			if (rc != 0)
 				D_GOTO(reply, rc);
 
@@ -37,6 +37,7 @@ dfuse_cb_write(fuse_req_t req, fuse_ino_t ino, struct fuse_bufvec *bufv, off_t p
 	bool                  wb_cache = false;
 
 	DFUSE_IE_STAT_ADD(oh->doh_ie, DS_WRITE);
+	DFUSE_CONT_MODIFIED(oh->doh_ie->ie_dfs);
 
 	oh->doh_linear_read = false;
 
@@ -4,6 +4,15 @@
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
 
+/* Interception of the libaio API for files on DFS. Requests on DFS files are issued as DFS async
+ * I/O on a private event queue and reported by io_getevents(), all other requests are passed to the
+ * kernel context. io_uring is not intercepted. liburing does export io_uring_queue_init*(),
+ * io_uring_submit() and __io_uring_get_cqe(), but io_uring_peek_cqe(), io_uring_cqe_seen() and the
+ * fast path of io_uring_wait_cqe() are inline in liburing.h and read the completion ring that is
+ * shared with the kernel directly. Completions of DFS requests would have to be written into that
+ * ring, racing with the kernel, so io_uring requests on dfuse files are served by dfuse.
+ */
+
 #define D_LOGFAC DD_FAC(il)
 
 #include <libaio.h>
@@ -17,6 +26,7 @@
 #include <daos_fs.h>
 #include <daos/debug.h>
 #include <daos/common.h>
+#include <daos/event.h>
 
 #include "pil4dfs_int.h"
 
@@ -28,15 +38,20 @@ extern struct file_obj  *d_file_list[MAX_OPENED_FILE];
 extern int
 d_get_fd_redirected(int fd);
 
-typedef struct d_aio_req_args {
-	d_iov_t	    iov;
-	d_sg_list_t sgl;
-}d_aio_req_args_t;
+/* number of iovecs of a vectored request that can be handled without allocation */
+#define AIO_IOV_INLINE 4
 
+/* request descriptor, preallocated per context and reused */
 struct d_aio_ev {
 	daos_event_t      ev;
 	struct iocb      *piocb;
 	struct d_aio_ctx *ctx;
+	/* link in the free list of the context */
+	d_list_t          link;
+	d_sg_list_t       sgl;
+	d_iov_t           iov_inline[AIO_IOV_INLINE];
+	/* bytes read, or bytes to be written */
+	daos_size_t       size;
 };
 
 struct d_aio_ctx {
@@ -50,6 +65,11 @@ struct d_aio_ctx {
 	bool          on_dfs;
 	uint64_t      n_op_queued;
 	uint64_t      n_op_done;
+	/* requests on non-DFS files passed through to the real context */
+	uint64_t      n_op_sys;
+	/* pool of depth request descriptors */
+	struct d_aio_ev *evs;
+	d_list_t         free_evs;
 };
 
 typedef struct d_aio_ctx d_aio_ctx_t;
@@ -110,7 +130,10 @@ io_setup(int maxevents, io_context_t *ctxp)
 	aio_ctx_obj->eq.cookie   = 0;
 	aio_ctx_obj->n_op_queued = 0;
 	aio_ctx_obj->n_op_done   = 0;
+	aio_ctx_obj->n_op_sys    = 0;
+	aio_ctx_obj->evs         = NULL;
 	aio_ctx_obj->inited      = false;
+	D_INIT_LIST_HEAD(&aio_ctx_obj->free_evs);
 	aio_ctx_obj->on_dfs      = false;
 	*ctxp                    = (io_context_t)aio_ctx_obj;
 
@@ -127,10 +150,25 @@ io_setup(int maxevents, io_context_t *ctxp)
 	return 0;
 }
 
+static void
+aio_evs_fini(d_aio_ctx_t *aio_ctx, int nr)
+{
+	int i;
+	int rc;
+
+	for (i = 0; i < nr; i++) {
+		rc = daos_event_fini(&aio_ctx->evs[i].ev);
+		if (rc)
+			DL_ERROR(rc, "daos_event_fini() failed");
+	}
+	D_FREE(aio_ctx->evs);
+	D_INIT_LIST_HEAD(&aio_ctx->free_evs);
+}
+
 int
 io_destroy(io_context_t ctx)
 {
-	int          rc;
+	int          rc = 0;
 	d_aio_ctx_t *aio_ctx_obj = (d_aio_ctx_t *)ctx;
 	io_context_t ctx_save    = aio_ctx_obj->ctx;
 
@@ -138,7 +176,10 @@ io_destroy(io_context_t ctx)
 		next_io_destroy = dlsym(RTLD_NEXT, "io_destroy");
 		D_ASSERT(next_io_destroy != NULL);
 	}
-	rc = daos_eq_destroy(aio_ctx_obj->eq, 0);
+	if (aio_ctx_obj->inited) {
+		aio_evs_fini(aio_ctx_obj, aio_ctx_obj->depth);
+		rc = daos_eq_destroy(aio_ctx_obj->eq, 0);
+	}
 	D_FREE(aio_ctx_obj);
 	if (rc)
 		return (-daos_der2errno(rc));
@@ -150,6 +191,7 @@ static int
 create_ev_eq_for_aio(d_aio_ctx_t *aio_ctx)
 {
 	int          rc;
+	int          i;
 
 	if (aio_ctx->inited)
 		return 0;
@@ -158,20 +200,148 @@ create_ev_eq_for_aio(d_aio_ctx_t *aio_ctx)
 	rc  = daos_eq_create(&aio_ctx->eq);
 	if (rc)
 		goto err;
+
+	/* at most depth requests can be in flight, preallocate their descriptors */
+	D_ALLOC_ARRAY(aio_ctx->evs, aio_ctx->depth);
+	if (aio_ctx->evs == NULL)
+		D_GOTO(err_eq, rc = -DER_NOMEM);
+	for (i = 0; i < aio_ctx->depth; i++) {
+		rc = daos_event_init(&aio_ctx->evs[i].ev, aio_ctx->eq, NULL);
+		if (rc) {
+			DL_ERROR(rc, "daos_event_init() failed");
+			aio_evs_fini(aio_ctx, i);
+			D_GOTO(err_eq, rc);
+		}
+		aio_ctx->evs[i].ctx = aio_ctx;
+		d_list_add_tail(&aio_ctx->evs[i].link, &aio_ctx->free_evs);
+	}
 	aio_ctx->on_dfs = true;
 	aio_ctx->inited = true;
 
 	return 0;
 
+err_eq:
+	daos_eq_destroy(aio_ctx->eq, 0);
 err:
 	return daos_der2errno(rc);
 }
 
+static void
+aio_ev_release(struct d_aio_ev *ctx_ev)
+{
+	if (ctx_ev->sgl.sg_iovs != ctx_ev->iov_inline)
+		D_FREE(ctx_ev->sgl.sg_iovs);
+	ctx_ev->sgl.sg_iovs = NULL;
+	d_list_add(&ctx_ev->link, &ctx_ev->ctx->free_evs);
+}
+
+static bool
+aio_op_supported(short op)
+{
+	switch (op) {
+	case IO_CMD_PREAD:
+	case IO_CMD_PWRITE:
+	case IO_CMD_PREADV:
+	case IO_CMD_PWRITEV:
+	case IO_CMD_FSYNC:
+	case IO_CMD_FDSYNC:
+		return true;
+	default:
+		return false;
+	}
+}
+
+/* set up the scatter/gather list of a request from its plain or vectored buffer */
+static int
+aio_ev_set_sgl(struct d_aio_ev *ctx_ev, struct iocb *iocb)
+{
+	struct iovec *iov;
+	d_iov_t      *iovs;
+	int           nr;
+	int           i;
+
+	if (iocb->aio_lio_opcode == IO_CMD_PREAD || iocb->aio_lio_opcode == IO_CMD_PWRITE) {
+		d_iov_set(&ctx_ev->iov_inline[0], iocb->u.c.buf, iocb->u.c.nbytes);
+		ctx_ev->sgl.sg_nr   = 1;
+		ctx_ev->sgl.sg_iovs = ctx_ev->iov_inline;
+		ctx_ev->size        = iocb->u.c.nbytes;
+		return 0;
+	}
+
+	/* for vectored requests, buf is the iovec array and nbytes the number of iovecs */
+	iov = (struct iovec *)iocb->u.v.vec;
+	nr  = iocb->u.v.nr;
+	if (nr <= 0)
+		return EINVAL;
+	if (nr <= AIO_IOV_INLINE) {
+		iovs = ctx_ev->iov_inline;
+	} else {
+		D_ALLOC_ARRAY(iovs, nr);
+		if (iovs == NULL)
+			return ENOMEM;
+	}
+	ctx_ev->size = 0;
+	for (i = 0; i < nr; i++) {
+		d_iov_set(&iovs[i], iov[i].iov_base, iov[i].iov_len);
+		ctx_ev->size += iov[i].iov_len;
+	}
+	ctx_ev->sgl.sg_nr   = nr;
+	ctx_ev->sgl.sg_iovs = iovs;
+	return 0;
+}
+
+/* start one request on a DFS file, return 0 or errno */
 static int
-aio_req_cb(void *args, daos_event_t *ev, int ret)
+aio_submit_dfs(d_aio_ctx_t *aio_ctx, struct iocb *iocb, int fd)
 {
-	D_FREE(args);
+	struct d_aio_ev *ctx_ev;
+	short            op = iocb->aio_lio_opcode;
+	daos_off_t       offset;
+	int              rc;
+
+	ctx_ev = d_list_pop_entry(&aio_ctx->free_evs, struct d_aio_ev, link);
+	if (ctx_ev == NULL)
+		return EAGAIN;
+	ctx_ev->piocb       = iocb;
+	ctx_ev->sgl.sg_iovs = NULL;
+
+	if (op == IO_CMD_FSYNC || op == IO_CMD_FDSYNC) {
+		/* completed DFS writes are already persistent, nothing to flush */
+		ctx_ev->size = 0;
+		rc = daos_event_launch(&ctx_ev->ev);
+		if (rc) {
+			DL_ERROR(rc, "daos_event_launch() failed");
+			D_GOTO(err, rc = daos_der2errno(rc));
+		}
+		daos_event_complete(&ctx_ev->ev, 0);
+		goto out;
+	}
+
+	rc = aio_ev_set_sgl(ctx_ev, iocb);
+	if (rc)
+		D_GOTO(err, rc);
+
+	if (op == IO_CMD_PREADV || op == IO_CMD_PWRITEV)
+		offset = iocb->u.v.offset;
+	else
+		offset = iocb->u.c.offset;
+
+	if (op == IO_CMD_PREAD || op == IO_CMD_PREADV)
+		rc = dfs_read(d_file_list[fd]->dfs_mt->dfs, d_file_list[fd]->file, &ctx_ev->sgl,
+			      offset, &ctx_ev->size, &ctx_ev->ev);
+	else
+		rc = dfs_write(d_file_list[fd]->dfs_mt->dfs, d_file_list[fd]->file, &ctx_ev->sgl,
+			       offset, &ctx_ev->ev);
+	if (rc)
+		D_GOTO(err, rc);
+
+out:
+	aio_ctx->n_op_queued++;
 	return 0;
+
+err:
+	aio_ev_release(ctx_ev);
+	return rc;
 }
 
 int
@@ -179,12 +349,8 @@ io_submit(io_context_t ctx, long nr, struct iocb *ios[])
 {
 	d_aio_ctx_t      *aio_ctx_obj = (d_aio_ctx_t *)ctx;
 	io_context_t      ctx_real    = aio_ctx_obj->ctx;
-	daos_size_t       read_size   = 0;
-	struct d_aio_ev  *ctx_ev      = NULL;
-	d_aio_req_args_t *req_args;
-	int               i, n_op_dfs, fd, io_depth;
-	int               rc, rc2;
-	short             op;
+	int               i, j, n_op_dfs, fd, io_depth;
+	int               rc;
 	int              *fd_directed = NULL;
 
 	if (next_io_submit == NULL) {
@@ -206,27 +372,19 @@ io_submit(io_context_t ctx, long nr, struct iocb *ios[])
 	n_op_dfs = 0;
 	for (i = 0; i < nr; i++) {
 		fd_directed[i] = d_get_fd_redirected(ios[i]->aio_fildes);
-		if (fd_directed[i] >= FD_FILE_BASE)
-			n_op_dfs++;
+		if (fd_directed[i] < FD_FILE_BASE)
+			continue;
+		n_op_dfs++;
 
-		op = ios[i]->aio_lio_opcode;
-		/* only support IO_CMD_PREAD and IO_CMD_PWRITE */
-		if (op != IO_CMD_PREAD && op != IO_CMD_PWRITE) {
-			DS_ERROR(EINVAL, "io_submit only supports PREAD and PWRITE for now");
+		if (!aio_op_supported(ios[i]->aio_lio_opcode)) {
+			DS_ERROR(EINVAL, "io_submit does not support opcode %d on DFS files",
+				 ios[i]->aio_lio_opcode);
 			D_GOTO(err, rc = EINVAL);
 		}
 	}
 	if (n_op_dfs == 0)
 		goto org;
 
-	if (n_op_dfs != nr) {
-		if (d_compatible_mode)
-			goto org;
-		DS_ERROR(EINVAL, "io_submit() does not support mixed non-dfs and dfs files yet in"
-			 " regular mode");
-		D_GOTO(err, rc = EINVAL);
-	}
-
 	if (!aio_ctx_obj->inited) {
 		rc = create_ev_eq_for_aio(aio_ctx_obj);
 		if (rc)
@@ -234,74 +392,43 @@ io_submit(io_context_t ctx, long nr, struct iocb *ios[])
 	}
 
 	for (i = 0; i < nr; i++) {
-		op = ios[i]->aio_lio_opcode;
-		fd = fd_directed[i] - FD_FILE_BASE;
-
-		D_ALLOC_PTR(ctx_ev);
-		if (ctx_ev == NULL)
-			D_GOTO(err_loop, rc = ENOMEM);
-
-		rc = daos_event_init(&ctx_ev->ev, aio_ctx_obj->eq, NULL);
-		if (rc) {
-			DL_ERROR(rc, "daos_event_init() failed");
-			D_GOTO(err_loop, rc = daos_der2errno(rc));
-		}
-		ctx_ev->piocb = ios[i];
-		/* EQs are shared by contexts. Need to save ctx when polling EQs. */
-		ctx_ev->ctx = aio_ctx_obj;
-		D_ALLOC_PTR(req_args);
-		if (req_args == NULL)
-			D_GOTO(err_loop, rc = ENOMEM);
-		d_iov_set(&req_args->iov, (void *)ios[i]->u.c.buf, ios[i]->u.c.nbytes);
-		req_args->sgl.sg_nr     = 1;
-		req_args->sgl.sg_iovs   = &req_args->iov;
-
-		if (op == IO_CMD_PREAD) {
-			rc = daos_event_register_comp_cb(&ctx_ev->ev, aio_req_cb, req_args);
-			if (rc) {
-				DL_ERROR(rc, "daos_event_register_comp_cb() failed");
-				D_GOTO(err_loop, rc);
-			}
-			rc = dfs_read(d_file_list[fd]->dfs_mt->dfs, d_file_list[fd]->file,
-				      &req_args->sgl, ios[i]->u.c.offset, &read_size, &ctx_ev->ev);
-			if (rc) {
-				rc2 = daos_event_fini(&ctx_ev->ev);
-				if (rc2)
-					DL_ERROR(rc2, "daos_event_fini() failed");
-				D_GOTO(err_loop, rc);
+		if (fd_directed[i] < FD_FILE_BASE) {
+			/* pass consecutive requests on non-DFS files through to the real context */
+			for (j = i + 1; j < nr && fd_directed[j] < FD_FILE_BASE; j++)
+				;
+			rc = next_io_submit(ctx_real, j - i, &ios[i]);
+			if (rc < 0)
+				D_GOTO(err_loop, rc = -rc);
+			aio_ctx_obj->n_op_sys += rc;
+			if (rc < j - i) {
+				i += rc;
+				break;
 			}
+			i = j - 1;
+			continue;
 		}
-		if (op == IO_CMD_PWRITE) {
-			rc = daos_event_register_comp_cb(&ctx_ev->ev, aio_req_cb, req_args);
-			if (rc) {
-				DL_ERROR(rc, "daos_event_register_comp_cb() failed");
-				D_GOTO(err_loop, rc);
-			}
-			rc = dfs_write(d_file_list[fd]->dfs_mt->dfs, d_file_list[fd]->file,
-				       &req_args->sgl, ios[i]->u.c.offset, &ctx_ev->ev);
-			if (rc) {
-				rc2 = daos_event_fini(&ctx_ev->ev);
-				if (rc2)
-					DL_ERROR(rc2, "daos_event_fini() failed");
-				D_GOTO(err_loop, rc);
-			}
-		}
-		aio_ctx_obj->n_op_queued++;
+
+		fd = fd_directed[i] - FD_FILE_BASE;
+		rc = aio_submit_dfs(aio_ctx_obj, ios[i], fd);
+		if (rc)
+			D_GOTO(err_loop, rc);
 	}
 
 	D_FREE(fd_directed);
-	return nr;
+	return i;
 
 org:
 	D_FREE(fd_directed);
-	return next_io_submit(ctx_real, nr, ios);
+	rc = next_io_submit(ctx_real, nr, ios);
+	if (rc > 0)
+		aio_ctx_obj->n_op_sys += rc;
+	return rc;
 
 err:
 	D_FREE(fd_directed);
 	return (-rc);
 
 err_loop:
-	D_FREE(ctx_ev);
 	D_FREE(fd_directed);
 
 	return i ? i : (-rc);
@@ -335,7 +462,7 @@ static void
 aio_poll_eq(struct d_aio_ctx *ctx, long min_nr, long nr, struct io_event *events, int *num_ev)
 {
 	int                j;
-	int                rc, rc2;
+	int                rc;
 	struct daos_event *eps[AIO_EQ_DEPTH + 1] = {0};
 	struct d_aio_ev   *p_aio_ev;
 
@@ -347,22 +474,20 @@ aio_poll_eq(struct d_aio_ctx *ctx, long min_nr, long nr, struct io_event *events
 		DL_ERROR(rc, "daos_eq_poll() failed");
 
 	for (j = 0; j < rc; j++) {
+		p_aio_ev = container_of(eps[j], struct d_aio_ev, ev);
+		ctx->n_op_queued--;
+		ctx->n_op_done++;
+		/* append to event list, failed requests report a negative errno like the kernel */
+		events[*num_ev].obj  = p_aio_ev->piocb;
+		events[*num_ev].res2 = 0;
 		if (eps[j]->ev_error) {
-			DS_ERROR(eps[j]->ev_error, "daos_eq_poll() error");
+			DS_ERROR(eps[j]->ev_error, "aio request failed");
+			events[*num_ev].res = -eps[j]->ev_error;
 		} else {
-			ctx->n_op_queued--;
-			ctx->n_op_done++;
-			p_aio_ev = container_of(eps[j], struct d_aio_ev, ev);
-			/* append to event list */
-			events[*num_ev].obj = p_aio_ev->piocb;
-			events[*num_ev].res = p_aio_ev->piocb->u.c.nbytes;
-
-			rc2 = daos_event_fini(&p_aio_ev->ev);
-			if (rc2)
-				DL_ERROR(rc2, "daos_event_fini() failed");
-			(*num_ev)++;
-			D_FREE(p_aio_ev);
+			events[*num_ev].res = p_aio_ev->size;
 		}
+		(*num_ev)++;
+		aio_ev_release(p_aio_ev);
 	}
 
 	return;
@@ -385,6 +510,8 @@ io_getevents(io_context_t ctx, long min_nr, long nr, struct io_event *events,
 	struct timespec times_0;
 	struct timespec times_1;
 	struct timespec dt;
+	struct timespec no_wait = {0};
+	int             rc;
 
 	if (next_io_getevents == NULL)
 		next_io_getevents = io_getevents_sys;
@@ -394,8 +521,12 @@ io_getevents(io_context_t ctx, long min_nr, long nr, struct io_event *events,
 
 	if (aio_ctx_obj->depth == 0)
 		return next_io_getevents(ctx_real, min_nr, nr, events, timeout);
-	if (!aio_ctx_obj->on_dfs)
-		return next_io_getevents(ctx_real, min_nr, nr, events, timeout);
+	if (!aio_ctx_obj->on_dfs) {
+		rc = next_io_getevents(ctx_real, min_nr, nr, events, timeout);
+		if (rc > 0)
+			aio_ctx_obj->n_op_sys -= rc;
+		return rc;
+	}
 	if (!aio_ctx_obj->inited) {
 		DS_ERROR(EINVAL, "event queue is not initialized yet");
 		return (-EINVAL);
@@ -406,8 +537,24 @@ io_getevents(io_context_t ctx, long min_nr, long nr, struct io_event *events,
 	if (min_nr > AIO_EQ_DEPTH)
 		min_nr = AIO_EQ_DEPTH;
 
+	/* nothing in flight on DFS, the real context can block on its own requests */
+	if (aio_ctx_obj->n_op_queued == 0) {
+		rc = next_io_getevents(ctx_real, min_nr, nr, events, timeout);
+		if (rc > 0)
+			aio_ctx_obj->n_op_sys -= rc;
+		return rc;
+	}
+
 	while (1) {
 		aio_poll_eq(aio_ctx_obj, min_nr, nr, events, &op_done);
+		if (aio_ctx_obj->n_op_sys > 0 && op_done < nr) {
+			rc = next_io_getevents(ctx_real, 0, nr - op_done, events + op_done,
+					       &no_wait);
+			if (rc > 0) {
+				aio_ctx_obj->n_op_sys -= rc;
+				op_done += rc;
+			}
+		}
 		if (op_done >= min_nr)
 			return op_done;
 		if (timeout) {
@@ -518,3 +518,275 @@ ds3_part_set_info(struct ds3_multipart_part_info *info, ds3_part_t *ds3p, ds3_t
 	return -dfs_setxattr(ds3->meta_dfs, ds3p->dfs_obj, RGW_PART_XATTR, info->encoded,
 			     info->encoded_length, 0);
 }
+
+/** Number of copy buffers in flight while completing an upload */
+#define UPLOAD_COPY_SLOTS 16
+/** Size of one copy buffer */
+#define UPLOAD_COPY_SIZE  (4 * 1024 * 1024)
+
+struct upload_copy_slot {
+	daos_event_t ev;
+	char        *buf;
+	d_iov_t      iov;
+	d_sg_list_t  sgl;
+	dfs_obj_t   *part;
+	daos_off_t   src_off;
+	daos_off_t   dst_off;
+	daos_size_t  size;
+	daos_size_t  read_size;
+	bool         reading;
+};
+
+struct upload_copy {
+	ds3_t        *ds3;
+	ds3_bucket_t *ds3b;
+	ds3_obj_t    *ds3o;
+	dfs_obj_t   **parts;
+	daos_size_t  *part_sizes;
+	uint32_t      nparts;
+	/* next chunk to copy */
+	uint32_t      cur_part;
+	daos_off_t    cur_off;
+	daos_off_t    dst_off;
+	int           inflight;
+	int           rc;
+};
+
+/* Start copying the next chunk with \a slot, returns false if there is nothing left to copy */
+static bool
+upload_copy_next(struct upload_copy *uc, struct upload_copy_slot *slot)
+{
+	int rc;
+
+	while (uc->cur_part < uc->nparts && uc->cur_off >= uc->part_sizes[uc->cur_part]) {
+		uc->cur_part++;
+		uc->cur_off = 0;
+	}
+	if (uc->rc != 0 || uc->cur_part == uc->nparts)
+		return false;
+
+	slot->part    = uc->parts[uc->cur_part];
+	slot->src_off = uc->cur_off;
+	slot->dst_off = uc->dst_off;
+	slot->size    = min(uc->part_sizes[uc->cur_part] - uc->cur_off, UPLOAD_COPY_SIZE);
+	slot->reading = true;
+	uc->cur_off += slot->size;
+	uc->dst_off += slot->size;
+
+	d_iov_set(&slot->iov, slot->buf, slot->size);
+	slot->sgl.sg_nr     = 1;
+	slot->sgl.sg_nr_out = 0;
+	slot->sgl.sg_iovs   = &slot->iov;
+	rc = dfs_read(uc->ds3->meta_dfs, slot->part, &slot->sgl, slot->src_off, &slot->read_size,
+		      &slot->ev);
+	if (rc != 0) {
+		uc->rc = rc;
+		return false;
+	}
+	uc->inflight++;
+	return true;
+}
+
+/* Move \a slot to its next step once its read or write completed */
+static void
+upload_copy_complete(struct upload_copy *uc, struct upload_copy_slot *slot)
+{
+	int rc = slot->ev.ev_error;
+
+	uc->inflight--;
+	if (rc != 0) {
+		D_ERROR("Failed to %s multipart part: %d\n", slot->reading ? "read" : "write", rc);
+		if (uc->rc == 0)
+			uc->rc = rc;
+		return;
+	}
+
+	if (!slot->reading) {
+		upload_copy_next(uc, slot);
+		return;
+	}
+
+	/* parts are not modified once the upload is being completed */
+	if (slot->read_size != slot->size) {
+		D_ERROR("Short read of multipart part, " DF_U64 "/" DF_U64 "\n", slot->read_size,
+			slot->size);
+		if (uc->rc == 0)
+			uc->rc = EIO;
+		return;
+	}
+
+	slot->reading = false;
+	rc = dfs_write(uc->ds3b->dfs, uc->ds3o->dfs_obj, &slot->sgl, slot->dst_off, &slot->ev);
+	if (rc != 0) {
+		if (uc->rc == 0)
+			uc->rc = rc;
+		return;
+	}
+	uc->inflight++;
+}
+
+static int
+upload_copy_parts(struct upload_copy *uc)
+{
+	struct upload_copy_slot *slots;
+	daos_event_t            *evs[UPLOAD_COPY_SLOTS];
+	daos_handle_t            eqh;
+	int                      nslots = 0;
+	int                      rc;
+	int                      rc2;
+	int                      i;
+
+	rc = daos_eq_create(&eqh);
+	if (rc != 0)
+		return daos_der2errno(rc);
+
+	D_ALLOC_ARRAY(slots, UPLOAD_COPY_SLOTS);
+	if (slots == NULL)
+		D_GOTO(out_eq, rc = ENOMEM);
+
+	for (nslots = 0; nslots < UPLOAD_COPY_SLOTS; nslots++) {
+		D_ALLOC(slots[nslots].buf, UPLOAD_COPY_SIZE);
+		if (slots[nslots].buf == NULL)
+			D_GOTO(out_slots, rc = ENOMEM);
+		rc = daos_event_init(&slots[nslots].ev, eqh, NULL);
+		if (rc != 0) {
+			D_FREE(slots[nslots].buf);
+			D_GOTO(out_slots, rc = daos_der2errno(rc));
+		}
+	}
+
+	for (i = 0; i < nslots; i++) {
+		if (!upload_copy_next(uc, &slots[i]))
+			break;
+	}
+
+	while (uc->inflight > 0) {
+		rc = daos_eq_poll(eqh, 1, DAOS_EQ_WAIT, UPLOAD_COPY_SLOTS, evs);
+		if (rc < 0) {
+			D_ERROR("daos_eq_poll() failed: " DF_RC "\n", DP_RC(rc));
+			if (uc->rc == 0)
+				uc->rc = daos_der2errno(rc);
+			break;
+		}
+		for (i = 0; i < rc; i++)
+			upload_copy_complete(uc, container_of(evs[i], struct upload_copy_slot, ev));
+	}
+	rc = 0;
+
+	/*
+	 * The EQ could not be polled anymore, abort the copies still in flight by destroying it
+	 * before releasing their buffers. If even that fails, the buffers might still be written
+	 * into and are leaked.
+	 */
+	if (uc->inflight > 0) {
+		rc2 = daos_eq_destroy(eqh, DAOS_EQ_DESTROY_FORCE);
+		if (rc2 != 0) {
+			D_ERROR("Failed to abort %d copies in flight, leaking their buffers: " DF_RC
+				"\n", uc->inflight, DP_RC(rc2));
+			return rc;
+		}
+		for (i = 0; i < nslots; i++)
+			D_FREE(slots[i].buf);
+		D_FREE(slots);
+		return rc;
+	}
+
+out_slots:
+	for (i = 0; i < nslots; i++) {
+		rc2 = daos_event_fini(&slots[i].ev);
+		if (rc2 != 0)
+			D_ERROR("daos_event_fini() failed: " DF_RC "\n", DP_RC(rc2));
+		D_FREE(slots[i].buf);
+	}
+	D_FREE(slots);
+out_eq:
+	rc2 = daos_eq_destroy(eqh, DAOS_EQ_DESTROY_FORCE);
+	if (rc2 != 0)
+		D_ERROR("daos_eq_destroy() failed: " DF_RC "\n", DP_RC(rc2));
+	return rc;
+}
+
+int
+ds3_upload_complete(const char *bucket_name, const char *upload_id, const uint64_t *part_nums,
+		    uint32_t nparts, ds3_obj_t *ds3o, ds3_bucket_t *ds3b, ds3_t *ds3,
+		    daos_size_t *size)
+{
+	struct upload_copy uc  = {0};
+	int                rc  = 0;
+	int                rc2 = 0;
+	dfs_obj_t         *multipart_dir;
+	dfs_obj_t         *upload_dir;
+	char               part_name_str[7];
+	uint32_t           nopen = 0;
+	uint32_t           i;
+
+	if (bucket_name == NULL || upload_id == NULL || part_nums == NULL || ds3o == NULL ||
+	    ds3b == NULL || ds3 == NULL)
+		return -EINVAL;
+	if (nparts == 0 || nparts > MULTIPART_MAX_PARTS)
+		return -EINVAL;
+
+	D_ALLOC_ARRAY(uc.parts, nparts);
+	if (uc.parts == NULL)
+		return -ENOMEM;
+	D_ALLOC_ARRAY(uc.part_sizes, nparts);
+	if (uc.part_sizes == NULL)
+		D_GOTO(err_parts, rc = ENOMEM);
+
+	rc = dfs_lookup_rel(ds3->meta_dfs, ds3->meta_dirs[MULTIPART_DIR], bucket_name, O_RDWR,
+			    &multipart_dir, NULL, NULL);
+	if (rc != 0)
+		goto err_parts;
+
+	rc = dfs_lookup_rel(ds3->meta_dfs, multipart_dir, upload_id, O_RDWR, &upload_dir, NULL,
+			    NULL);
+	if (rc != 0)
+		goto err_multipart_dir;
+
+	for (nopen = 0; nopen < nparts; nopen++) {
+		if (part_nums[nopen] > MULTIPART_MAX_PARTS)
+			D_GOTO(err_open, rc = EINVAL);
+		sprintf(part_name_str, "%06lu", part_nums[nopen]);
+		rc = dfs_open(ds3->meta_dfs, upload_dir, part_name_str, S_IFREG, O_RDONLY, 0, 0,
+			      NULL, &uc.parts[nopen]);
+		if (rc != 0)
+			goto err_open;
+		rc = dfs_get_size(ds3->meta_dfs, uc.parts[nopen], &uc.part_sizes[nopen]);
+		if (rc != 0) {
+			dfs_release(uc.parts[nopen]);
+			goto err_open;
+		}
+	}
+
+	/* The object may already exist and be larger than the parts, truncate it first */
+	rc = dfs_punch(ds3b->dfs, ds3o->dfs_obj, 0, DFS_MAX_FSIZE);
+	if (rc != 0) {
+		D_ERROR("Failed to truncate object, rc=%d\n", rc);
+		goto err_open;
+	}
+
+	uc.ds3    = ds3;
+	uc.ds3b   = ds3b;
+	uc.ds3o   = ds3o;
+	uc.nparts = nparts;
+	rc        = upload_copy_parts(&uc);
+	if (rc == 0)
+		rc = uc.rc;
+	if (rc == 0 && size != NULL)
+		*size = uc.dst_off;
+
+err_open:
+	for (i = 0; i < nopen; i++) {
+		rc2 = dfs_release(uc.parts[i]);
+		rc  = rc == 0 ? rc2 : rc;
+	}
+	rc2 = dfs_release(upload_dir);
+	rc  = rc == 0 ? rc2 : rc;
+err_multipart_dir:
+	rc2 = dfs_release(multipart_dir);
+	rc  = rc == 0 ? rc2 : rc;
+err_parts:
+	D_FREE(uc.part_sizes);
+	D_FREE(uc.parts);
+	return -rc;
+}
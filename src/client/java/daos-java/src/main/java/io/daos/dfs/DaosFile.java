@@ -666,6 +666,14 @@ public class DaosFile {
     return objId;
   }
 
+  protected long getDfsPtr() {
+    return dfsPtr;
+  }
+
+  protected DaosFsClient getClient() {
+    return client;
+  }
+
   @Override
   public String toString() {
     return path;
@@ -65,6 +65,12 @@ public final class DaosFsClient extends ShareableClient implements ForceCloseabl
 
   private static final Logger log = LoggerFactory.getLogger(DaosFsClient.class);
 
+  /**
+   * length of each entry of the buffer passed to {@link #dfsBatchAsync(long, long, int)}, object id +
+   * desc buffer address + read flag. It's exported to native code by the generated JNI header.
+   */
+  public static final int BATCH_ENTRY_LEN = 8 + 8 + 8;
+
   static {
     DaosClient.initClient();
   }
@@ -660,6 +666,21 @@ public final class DaosFsClient extends ShareableClient implements ForceCloseabl
 
   native void dfsWriteAsync(long dfsPtr, long objId, long memoryAddress) throws IOException;
 
+  /**
+   * submit a batch of asynchronous reads and writes.
+   *
+   * @param dfsPtr
+   * pointer of dfs object
+   * @param batchBufAddress
+   * address of batch buffer, see {@link IODfsBatch}
+   * @param count
+   * number of entries in batch buffer
+   * @return number of entries submitted
+   * @throws IOException
+   * {@link DaosIOException}
+   */
+  native int dfsBatchAsync(long dfsPtr, long batchBufAddress, int count) throws IOException;
+
   /**
    * read children.
    *
@@ -0,0 +1,126 @@
+/*
+ * (C) Copyright 2018-2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+
+package io.daos.dfs;
+
+import io.daos.BufferAllocator;
+import io.netty.buffer.ByteBuf;
+
+import java.io.IOException;
+
+/**
+ * batch of asynchronous dfs reads and writes submitted to native with one JNI call.
+ * Each {@link IODfsDesc} added should have its event set. Completions are polled from the
+ * event queue of the descs, the same as {@link DaosFile#readAsync(IODfsDesc, long, long)}.
+ *
+ * <p>
+ * All files in a batch must be from the same {@link DaosFsClient}.
+ */
+public class IODfsBatch {
+
+  private final ByteBuf batchBuffer;
+  private final int capacity;
+  private int count;
+  private DaosFsClient client;
+  private long dfsPtr;
+
+  private boolean released;
+
+  public static final int ENTRY_LEN = DaosFsClient.BATCH_ENTRY_LEN;
+
+  public IODfsBatch(int capacity) {
+    if (capacity <= 0) {
+      throw new IllegalArgumentException("capacity should be positive, " + capacity);
+    }
+    this.capacity = capacity;
+    batchBuffer = BufferAllocator.objBufWithNativeOrder(capacity * ENTRY_LEN);
+  }
+
+  /**
+   * add asynchronous read to this batch.
+   *
+   * @param file    file to read
+   * @param desc    desc for request, buffer and event
+   * @param offset  file offset
+   * @param len     expected length in bytes read from file to buffer
+   * @throws IOException
+   * {@link io.daos.DaosIOException}
+   */
+  public void addRead(DaosFile file, IODfsDesc desc, long offset, long len) throws IOException {
+    desc.setReadOrWrite(true);
+    add(file, desc, offset, len, true);
+  }
+
+  /**
+   * add asynchronous write to this batch.
+   *
+   * @param file    file to write
+   * @param desc    desc for request, buffer and event
+   * @param offset  file offset
+   * @param len     length in bytes of data to write
+   * @throws IOException
+   * {@link io.daos.DaosIOException}
+   */
+  public void addWrite(DaosFile file, IODfsDesc desc, long offset, long len) throws IOException {
+    desc.setReadOrWrite(false);
+    add(file, desc, offset, len, false);
+  }
+
+  private void add(DaosFile file, IODfsDesc desc, long offset, long len, boolean read) throws IOException {
+    if (released) {
+      throw new IllegalStateException("batch is released");
+    }
+    if (count == capacity) {
+      throw new IllegalStateException("batch is full, capacity: " + capacity);
+    }
+    if (count == 0) {
+      client = file.getClient();
+      dfsPtr = file.getDfsPtr();
+    } else if (file.getDfsPtr() != dfsPtr) {
+      throw new IllegalArgumentException("all files in batch should be from same dfs, " + file);
+    }
+    long objId = file.getObjId();
+    desc.encode(offset, len);
+    batchBuffer.writerIndex(count * ENTRY_LEN);
+    batchBuffer.writeLong(objId);
+    batchBuffer.writeLong(desc.getDescBuffer().memoryAddress());
+    batchBuffer.writeLong(read ? 1L : 0L);
+    count++;
+  }
+
+  /**
+   * submit all requests of this batch with one JNI call. The batch is empty after submission and can be
+   * reused.
+   *
+   * @return number of requests submitted
+   * @throws IOException
+   * {@link io.daos.DaosIOException} if any request failed to be submitted. Requests before it are in flight.
+   */
+  public int submit() throws IOException {
+    if (count == 0) {
+      return 0;
+    }
+    int nbr = count;
+    count = 0;
+    return client.dfsBatchAsync(dfsPtr, batchBuffer.memoryAddress(), nbr);
+  }
+
+  public int getCount() {
+    return count;
+  }
+
+  public int getCapacity() {
+    return capacity;
+  }
+
+  public void release() {
+    if (released) {
+      return;
+    }
+    batchBuffer.release();
+    released = true;
+  }
+}
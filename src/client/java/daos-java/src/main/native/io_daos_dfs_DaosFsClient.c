@@ -1000,6 +1000,80 @@ Java_io_daos_dfs_DaosFsClient_dfsWriteAsync(JNIEnv *env, jobject client,
 	}
 }
 
+/**
+ * JNI method to submit a batch of asynchronous reads and writes with one JNI
+ * call. Each entry of the batch buffer is BATCH_ENTRY_LEN bytes of
+ * DaosFsClient: the opened fs object, the address of the entry's dfs description buffer (same layout as for
+ * dfsReadAsync/dfsWriteAsync) and a flag which is 1 for read, 0 for write.
+ * Completions are reported through the event queue of each description.
+ *
+ * \param[in]	env		JNI environment
+ * \param[in]	client		DaosFsClient object
+ * \param[in]	dfsPtr		pointer to dfs object
+ * \param[in]	batchBufAddress	address of batch buffer
+ * \param[in]	count		number of entries in batch buffer
+ *
+ * \return	number of entries submitted. It's less than \a count only if
+ *		an entry failed to be submitted, in which case an exception is
+ *		thrown too. Entries before it are in flight.
+ */
+JNIEXPORT jint JNICALL
+Java_io_daos_dfs_DaosFsClient_dfsBatchAsync(JNIEnv *env, jobject client,
+					    jlong dfsPtr, jlong batchBufAddress,
+					    jint count)
+{
+	dfs_t *dfs = *(dfs_t **)&dfsPtr;
+	char *buf = (char *)batchBufAddress;
+	uint64_t obj_mem;
+	uint64_t desc_buf;
+	uint64_t read;
+	uint64_t offset;
+	uint64_t len;
+	dfs_desc_t *desc;
+	int rc;
+	int i;
+
+	for (i = 0; i < count;
+	     i++, buf += io_daos_dfs_DaosFsClient_BATCH_ENTRY_LEN) {
+		memcpy(&obj_mem, buf, 8);
+		memcpy(&desc_buf, buf + 8, 8);
+		memcpy(&read, buf + 16, 8);
+
+		decode_dfs_desc((char *)desc_buf, &desc, &offset, &len);
+		desc->event->event.ev_error = 0;
+		rc = daos_event_register_comp_cb(&desc->event->event,
+						 read ? update_actual_size :
+						 update_ret_code, desc);
+		if (unlikely(rc != 0)) {
+			char *msg = NULL;
+
+			asprintf(&msg, "Failed to register dfs %s callback of "
+				 "batch entry %d", read ? "read" : "write", i);
+			throw_exc(env, msg, rc);
+			return i;
+		}
+		desc->event->status = EVENT_IN_USE;
+		if (read)
+			rc = dfs_read(dfs, (dfs_obj_t *)obj_mem, &desc->sgl,
+				      offset, &desc->size,
+				      &desc->event->event);
+		else
+			rc = dfs_write(dfs, (dfs_obj_t *)obj_mem, &desc->sgl,
+				       offset, &desc->event->event);
+		if (unlikely(rc != 0)) {
+			char *msg = NULL;
+
+			desc->event->status = 0;
+			asprintf(&msg, "Failed to %s %ld bytes of file starting "
+				 "at %ld, batch entry %d", read ? "read" : "write",
+				 len, offset, i);
+			throw_exc(env, msg, rc);
+			return i;
+		}
+	}
+	return count;
+}
+
 /**
  * JNI method to read children entries from directory denoted by \a objId.
  *
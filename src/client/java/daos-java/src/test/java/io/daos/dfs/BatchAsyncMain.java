@@ -0,0 +1,160 @@
+package io.daos.dfs;
+
+import io.daos.BufferAllocator;
+import io.daos.DaosClient;
+import io.daos.DaosEventQueue;
+import io.netty.buffer.ByteBuf;
+
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * Compare async writes or reads submitted with one JNI call per request ({@link DaosFile#writeAsync}
+ * and {@link DaosFile#readAsync}) against the same requests submitted with one JNI call per batch
+ * ({@link IODfsBatch}).
+ *
+ * <p>
+ * Usage: BatchAsyncMain pool_id container_id [write|read] [io size] [requests per round] [rounds]
+ */
+public class BatchAsyncMain {
+
+  private static final String FILE_NAME = "/batch_async_bench";
+
+  private static final int DEFAULT_IO_SIZE = 4096;
+  private static final int DEFAULT_NUMBER_OF_REQUESTS = 64;
+  private static final int DEFAULT_NUMBER_OF_ROUNDS = 1000;
+
+  public static void main(String[] args) throws Exception {
+    String poolId = args[0];
+    String containerId = args[1];
+    String op = args.length >= 3 ? args[2] : "write";
+    int ioSize = args.length >= 4 ? Integer.valueOf(args[3]) : DEFAULT_IO_SIZE;
+    if (ioSize <= 0) {
+      ioSize = DEFAULT_IO_SIZE;
+    }
+    int nbr = args.length >= 5 ? Integer.valueOf(args[4]) : DEFAULT_NUMBER_OF_REQUESTS;
+    if (nbr <= 0) {
+      nbr = DEFAULT_NUMBER_OF_REQUESTS;
+    }
+    int rounds = args.length >= 6 ? Integer.valueOf(args[5]) : DEFAULT_NUMBER_OF_ROUNDS;
+    if (rounds <= 0) {
+      rounds = DEFAULT_NUMBER_OF_ROUNDS;
+    }
+    boolean write;
+    if (op.equalsIgnoreCase("write")) {
+      write = true;
+    } else if (op.equalsIgnoreCase("read")) {
+      write = false;
+    } else {
+      System.out.println("unknown operation: " + op);
+      return;
+    }
+
+    DaosFsClient client = null;
+    DaosFile daosFile = null;
+    try {
+      client = new DaosFsClient.DaosFsClientBuilder().poolId(poolId).containerId(containerId).build();
+      daosFile = client.getFile(FILE_NAME);
+      if (!daosFile.exists()) {
+        daosFile.createNewFile();
+      }
+      run(daosFile, write, ioSize, nbr, rounds);
+      daosFile.delete();
+    } finally {
+      if (daosFile != null) {
+        daosFile.release();
+      }
+      if (client != null) {
+        client.close();
+      }
+      DaosClient.FINALIZER.run();
+    }
+  }
+
+  private static void run(DaosFile daosFile, boolean write, int ioSize, int nbr, int rounds)
+      throws IOException {
+    DaosEventQueue eq = DaosEventQueue.getInstance(nbr);
+    ByteBuf buffer = BufferAllocator.directNettyBuf(ioSize);
+    for (int i = 0; i < ioSize; i++) {
+      buffer.writeByte((i + 33) % 128);
+    }
+    IODfsDesc[] descs = new IODfsDesc[nbr];
+    for (int i = 0; i < nbr; i++) {
+      descs[i] = DaosFile.createDfsDesc(buffer, eq);
+    }
+    IODfsBatch batch = new IODfsBatch(nbr);
+    List<DaosEventQueue.Attachment> completed = new ArrayList<>();
+    long single = 0;
+    long batched = 0;
+    try {
+      if (!write) {
+        // populate the file for reads, not timed
+        runRound(daosFile, true, ioSize, descs, batch, eq, completed, true);
+      }
+      // interleave the two modes so that both see the same server state
+      for (int r = 0; r < rounds; r++) {
+        single += runRound(daosFile, write, ioSize, descs, batch, eq, completed, false);
+        batched += runRound(daosFile, write, ioSize, descs, batch, eq, completed, true);
+      }
+    } finally {
+      for (IODfsDesc desc : descs) {
+        if (desc != null) {
+          desc.release();
+        }
+      }
+      batch.release();
+      buffer.release();
+      DaosEventQueue.destroyAll();
+    }
+    long bytes = 1L * rounds * nbr * ioSize;
+    System.out.println(String.format("%d rounds of %d %ss of %d bytes", rounds, nbr,
+        write ? "write" : "read", ioSize));
+    System.out.println(String.format("single async: %d us, %.2f MB/s", single / 1000,
+        perf(bytes, single)));
+    System.out.println(String.format("batch async: %d us, %.2f MB/s", batched / 1000,
+        perf(bytes, batched)));
+  }
+
+  private static long runRound(DaosFile daosFile, boolean write, int ioSize, IODfsDesc[] descs,
+                               IODfsBatch batch, DaosEventQueue eq,
+                               List<DaosEventQueue.Attachment> completed, boolean batchMode)
+      throws IOException {
+    int nbr = descs.length;
+    long start = System.nanoTime();
+    for (int i = 0; i < nbr; i++) {
+      descs[i].reuse();
+      descs[i].setEvent(eq.acquireEvent());
+      long offset = (long) i * ioSize;
+      if (batchMode) {
+        if (write) {
+          batch.addWrite(daosFile, descs[i], offset, ioSize);
+        } else {
+          batch.addRead(daosFile, descs[i], offset, ioSize);
+        }
+      } else if (write) {
+        daosFile.writeAsync(descs[i], offset, ioSize);
+      } else {
+        daosFile.readAsync(descs[i], offset, ioSize);
+      }
+    }
+    if (batchMode) {
+      batch.submit();
+    }
+    completed.clear();
+    while (completed.size() < nbr) {
+      eq.pollCompleted(completed, IODfsDesc.class, null, nbr, 100);
+    }
+    long elapsed = System.nanoTime() - start;
+    for (IODfsDesc desc : descs) {
+      if (!desc.isSucceeded()) {
+        throw new IOException("failed " + desc);
+      }
+    }
+    return elapsed;
+  }
+
+  private static double perf(long bytes, long nanos) {
+    return nanos == 0 ? 0 : ((double) bytes) / 1024 / 1024 / (((double) nanos) / 1000000000);
+  }
+}
@@ -289,6 +289,130 @@ public class DaosFileIT {
     daosFile.release();
   }
 
+  @Test
+  public void testBatchAsyncWriteRead() throws Exception {
+    DaosFile daosFile = client.getFile("/data_async_batch");
+    daosFile.createNewFile();
+    int length = 100;
+    int nbr = 8;
+    DaosEventQueue eq = DaosEventQueue.getInstance(-1);
+    IODfsBatch batch = new IODfsBatch(nbr);
+    List<IODfsDesc> descs = new ArrayList<>();
+    List<ByteBuf> buffers = new ArrayList<>();
+    // write
+    for (int i = 0; i < nbr; i++) {
+      ByteBuf buffer = BufferAllocator.directNettyBuf(length);
+      for (int j = 0; j < length; j++) {
+        buffer.writeByte(i + j);
+      }
+      IODfsDesc desc = DaosFile.createDfsDesc(buffer, eq);
+      desc.setEvent(eq.acquireEvent());
+      batch.addWrite(daosFile, desc, i * length, length);
+      descs.add(desc);
+      buffers.add(buffer);
+    }
+    Assert.assertEquals(nbr, batch.submit());
+    Assert.assertEquals(0, batch.getCount());
+    List<DaosEventQueue.Attachment> completed = new ArrayList<>();
+    while (completed.size() < nbr) {
+      eq.pollCompleted(completed, IODfsDesc.class, null, nbr, 100);
+    }
+    for (IODfsDesc desc : descs) {
+      Assert.assertTrue(desc.isSucceeded());
+      desc.release();
+    }
+    Assert.assertEquals(nbr * length, daosFile.length());
+    descs.clear();
+    buffers.forEach(b -> b.release());
+    buffers.clear();
+    // read back with same batch
+    for (int i = 0; i < nbr; i++) {
+      ByteBuf buffer = BufferAllocator.directNettyBuf(length);
+      IODfsDesc desc = DaosFile.createDfsDesc(buffer, eq);
+      desc.setEvent(eq.acquireEvent());
+      batch.addRead(daosFile, desc, i * length, length);
+      descs.add(desc);
+      buffers.add(buffer);
+    }
+    Assert.assertEquals(nbr, batch.submit());
+    completed.clear();
+    while (completed.size() < nbr) {
+      eq.pollCompleted(completed, IODfsDesc.class, null, nbr, 100);
+    }
+    for (int i = 0; i < nbr; i++) {
+      IODfsDesc desc = descs.get(i);
+      Assert.assertTrue(desc.isSucceeded());
+      Assert.assertEquals(length, desc.getActualLength());
+      ByteBuf buffer = buffers.get(i);
+      for (int j = 0; j < length; j++) {
+        Assert.assertEquals((byte)(i + j), buffer.readByte());
+      }
+      desc.release();
+      buffer.release();
+    }
+    batch.release();
+    daosFile.release();
+  }
+
+  @Test
+  public void testBatchAsyncReuseDescWithSingleAsync() throws Exception {
+    DaosFile daosFile = client.getFile("/data_async_batch_reuse");
+    daosFile.createNewFile();
+    int length = 4096;
+    int nbr = 64;
+    DaosEventQueue eq = DaosEventQueue.getInstance(-1);
+    ByteBuf[] buffers = new ByteBuf[nbr];
+    IODfsDesc[] descs = new IODfsDesc[nbr];
+    for (int i = 0; i < nbr; i++) {
+      buffers[i] = BufferAllocator.directNettyBuf(length);
+      descs[i] = DaosFile.createDfsDesc(buffers[i], eq);
+    }
+    IODfsBatch batch = new IODfsBatch(nbr);
+    List<DaosEventQueue.Attachment> completed = new ArrayList<>();
+    // same descs alternate between single async and batch async writes, last round is batched
+    for (int mode = 0; mode < 4; mode++) {
+      for (int i = 0; i < nbr; i++) {
+        buffers[i].clear();
+        for (int j = 0; j < length; j++) {
+          buffers[i].writeByte(mode + i + j);
+        }
+        descs[i].reuse();
+        descs[i].setEvent(eq.acquireEvent());
+        if (mode % 2 == 0) {
+          daosFile.writeAsync(descs[i], (long)i * length, length);
+        } else {
+          batch.addWrite(daosFile, descs[i], (long)i * length, length);
+        }
+      }
+      if (mode % 2 == 1) {
+        Assert.assertEquals(nbr, batch.submit());
+      }
+      completed.clear();
+      while (completed.size() < nbr) {
+        eq.pollCompleted(completed, IODfsDesc.class, null, nbr, 100);
+      }
+      for (IODfsDesc desc : descs) {
+        Assert.assertTrue(desc.isSucceeded());
+      }
+    }
+    Assert.assertEquals((long)nbr * length, daosFile.length());
+    ByteBuf readBuf = BufferAllocator.directNettyBuf(length);
+    for (int i = 0; i < nbr; i++) {
+      readBuf.clear();
+      Assert.assertEquals(length, daosFile.read(readBuf, 0, (long)i * length, length));
+      for (int j = 0; j < length; j++) {
+        Assert.assertEquals((byte)(3 + i + j), readBuf.getByte(j));
+      }
+    }
+    readBuf.release();
+    for (int i = 0; i < nbr; i++) {
+      descs[i].release();
+      buffers[i].release();
+    }
+    batch.release();
+    daosFile.release();
+  }
+
   @Test
   public void testCreateNewFileSimple() throws Exception {
     DaosFile daosFile = client.getFile("/zjf");
@@ -2168,6 +2168,176 @@ out:
 	return rc;
 }
 
+/** Component of \a tree at the position of \a comp in the tree \a base */
+static struct pool_component *
+comp_rebase(struct pool_component *comp, struct pool_domain *base,
+	    struct pool_domain *tree)
+{
+	return (struct pool_component *)((char *)tree + ((char *)comp - (char *)base));
+}
+
+/** Check if two components only differ in their states */
+static bool
+comp_same_layout(struct pool_component *comp1, struct pool_component *comp2)
+{
+	return comp1->co_type == comp2->co_type && comp1->co_id == comp2->co_id &&
+	       comp1->co_rank == comp2->co_rank && comp1->co_index == comp2->co_index &&
+	       comp1->co_nr == comp2->co_nr;
+}
+
+/**
+ * Install a component tree which has the same layout as \a base to a pool
+ * map. IDs are immutable, so the sorters of \a base only need to be rebased
+ * on the new tree instead of being sorted again.
+ */
+static int
+pool_map_initialise_from(struct pool_map *map, struct pool_domain *tree,
+			 struct pool_map *base)
+{
+	struct pool_comp_sorter	*src;
+	struct pool_comp_sorter	*dst;
+	int			 i;
+	int			 j;
+	int			 rc;
+
+	D_ASSERT(pool_map_empty(map));
+
+	rc = D_MUTEX_INIT(&map->po_lock, NULL);
+	if (rc != 0) {
+		pool_tree_free(tree);
+		return rc;
+	}
+
+	map->po_tree = tree;
+	map->po_domain_layers = base->po_domain_layers;
+
+	D_ALLOC_ARRAY(map->po_comp_fail_cnts, map->po_domain_layers);
+	if (map->po_comp_fail_cnts == NULL)
+		D_GOTO(failed, rc = -DER_NOMEM);
+
+	D_ALLOC_ARRAY(map->po_domain_sorters, map->po_domain_layers);
+	if (map->po_domain_sorters == NULL)
+		D_GOTO(failed, rc = -DER_NOMEM);
+
+	for (i = 0; i <= map->po_domain_layers; i++) {
+		if (i < map->po_domain_layers) {
+			src = &base->po_domain_sorters[i];
+			dst = &map->po_domain_sorters[i];
+		} else {
+			src = &base->po_target_sorter;
+			dst = &map->po_target_sorter;
+		}
+
+		rc = comp_sorter_init(dst, src->cs_nr, src->cs_type);
+		if (rc != 0)
+			goto failed;
+
+		for (j = 0; j < src->cs_nr; j++)
+			dst->cs_comps[j] = comp_rebase(src->cs_comps[j], base->po_tree, tree);
+	}
+
+	map->po_in_ver = -1;
+	map->po_fseq = -1;
+	pool_map_init_in_fseq(map);
+	return 0;
+
+failed:
+	pool_map_finalise(map);
+	return rc;
+}
+
+/**
+ * Create a pool map from components stored in \a buf, same as
+ * pool_map_create(). If \a buf has the same components as \a base and only
+ * their states are different, which is the case of exclude, drain and
+ * reintegration, the new map is built from \a base without parsing the
+ * buffer or sorting the components again.
+ *
+ * \param base		[IN]	The pool map being replaced, can be NULL.
+ * \param buf		[IN]	The buffer to input pool components.
+ * \param version	[IN]	Version for the new created pool map.
+ * \param mapp		[OUT]	The returned pool map.
+ */
+int
+pool_map_create_incr(struct pool_map *base, struct pool_buf *buf, uint32_t version,
+		     struct pool_map **mapp)
+{
+	struct pool_comp_cntr	 cntr;
+	struct pool_component	*comp;
+	struct pool_domain	*tree;
+	struct pool_map		*map;
+	unsigned int		 dom_nr;
+	int			 i;
+	int			 rc;
+
+	if (base == NULL || base->po_tree == NULL)
+		return pool_map_create(buf, version, mapp);
+
+	/* The root is not stored in the buffer */
+	pool_tree_count(base->po_tree, &cntr);
+	dom_nr = cntr.cc_domains - 1;
+	if (buf->pb_nr != dom_nr + cntr.cc_targets ||
+	    buf->pb_domain_nr + buf->pb_node_nr != dom_nr ||
+	    buf->pb_target_nr != cntr.cc_targets)
+		return pool_map_create(buf, version, mapp);
+
+	for (i = 0; i < buf->pb_nr; i++) {
+		if (i < dom_nr)
+			comp = &base->po_tree[i + 1].do_comp;
+		else
+			comp = &base->po_tree[0].do_targets[i - dom_nr].ta_comp;
+		if (!comp_same_layout(comp, &buf->pb_comps[i]))
+			return pool_map_create(buf, version, mapp);
+	}
+
+	D_ALLOC(tree, pool_tree_size(base->po_tree));
+	if (tree == NULL)
+		return -DER_NOMEM;
+
+	pool_tree_copy(tree, base->po_tree);
+	for (i = 0; i < buf->pb_nr; i++) {
+		if (i < dom_nr)
+			tree[i + 1].do_comp = buf->pb_comps[i];
+		else
+			tree[0].do_targets[i - dom_nr].ta_comp = buf->pb_comps[i];
+	}
+
+	if (!pool_tree_sane(tree, version)) {
+		pool_tree_free(tree);
+		return -DER_INVAL;
+	}
+
+	D_ALLOC_PTR(map);
+	if (map == NULL) {
+		pool_tree_free(tree);
+		return -DER_NOMEM;
+	}
+
+	rc = pool_map_initialise_from(map, tree, base);
+	if (rc != 0) {
+		D_ERROR("pool_map_initialise_from failed: "DF_RC"\n", DP_RC(rc));
+		/* tree has been freed by pool_map_initialise_from() */
+		D_FREE(map);
+		return rc;
+	}
+
+	rc = pool_map_update_failed_cnt(map);
+	if (rc != 0) {
+		D_ERROR("could not update number of failed targets: "DF_RC"\n",
+			DP_RC(rc));
+		pool_map_finalise(map);
+		D_FREE(map);
+		return rc;
+	}
+
+	D_DEBUG(DB_TRACE, "Created pool map version %u from version %u\n", version,
+		base->po_version);
+	map->po_version = version;
+	map->po_ref = 1; /* 1 for caller */
+	*mapp = map;
+	return 0;
+}
+
 static bool
 child_status_check(struct pool_domain *domain, uint32_t status)
 {
@@ -17,7 +17,12 @@
 #include <daos_srv/iv.h>
 #include "srv_internal.h"
 
-#define OID_BLOCK 32
+/** Initial and maximum number of oids an IV node reserves from its parent */
+#define OID_BLOCK	32
+#define OID_BLOCK_MAX	(1 << 16)
+/** Forwards closer than this (in seconds) grow the block, idle ones shrink it */
+#define OID_BLOCK_GROW_INTVL	1
+#define OID_BLOCK_SHRINK_INTVL	30
 
 struct oid_iv_key {
 	/** The Key ID, being the container uuid */
@@ -34,6 +39,10 @@ struct oid_iv_entry {
 	ABT_mutex		lock;
 	d_rank_t                current_req_rank;
 	void                   *current_req_ptr;
+	/** number of oids to reserve from the parent, adapted to allocation rate */
+	daos_size_t		blk_size;
+	/** time of the last forward to the parent */
+	uint64_t		fwd_ts;
 };
 
 /** Priv data in the iv layer */
@@ -61,6 +70,29 @@ oid_iv_key_cmp(void *key1, void *key2)
 	return false;
 }
 
+/*
+ * Adapt the block size to how often this node runs out of oids, so that busy
+ * nodes keep a larger local range and do not hammer the root.
+ */
+static daos_size_t
+oid_iv_blk_size(struct oid_iv_entry *entry)
+{
+	uint64_t now = daos_gettime_coarse();
+
+	if (entry->blk_size == 0) {
+		entry->blk_size = OID_BLOCK;
+	} else if (now < entry->fwd_ts + OID_BLOCK_GROW_INTVL) {
+		if (entry->blk_size < OID_BLOCK_MAX)
+			entry->blk_size <<= 1;
+	} else if (now >= entry->fwd_ts + OID_BLOCK_SHRINK_INTVL) {
+		if (entry->blk_size > OID_BLOCK)
+			entry->blk_size >>= 1;
+	}
+	entry->fwd_ts = now;
+
+	return entry->blk_size;
+}
+
 static int
 oid_iv_ent_fetch(struct ds_iv_entry *entry, struct ds_iv_key *key,
 		 d_sg_list_t *src, void **priv)
@@ -130,6 +162,7 @@ oid_iv_ent_update(struct ds_iv_entry *ns_entry, struct ds_iv_key *iv_key,
 	struct oid_iv_range	*oids;
 	struct oid_iv_range	*avail;
 	daos_size_t		num_oids;
+	daos_size_t		blk_size;
 	d_rank_t		myrank = dss_self_rank();
 	int			rc;
 
@@ -200,15 +233,17 @@ oid_iv_ent_update(struct ds_iv_entry *ns_entry, struct ds_iv_key *iv_key,
 	}
 
 	/** increase the number of oids requested before forwarding */
-	if (num_oids < OID_BLOCK)
-		oids->num_oids = OID_BLOCK;
+	blk_size = oid_iv_blk_size(entry);
+	if (num_oids < blk_size)
+		oids->num_oids = blk_size;
 	else
-		oids->num_oids = (num_oids / OID_BLOCK) * OID_BLOCK * 2;
+		oids->num_oids = (num_oids / blk_size) * blk_size * 2;
 
 	/** Keep track of how much this node originally requested */
 	priv->num_oids = num_oids;
 
-	D_DEBUG(DB_MD, "%u: IDs not available, FORWARD %zu oids\n", myrank, oids->num_oids);
+	D_DEBUG(DB_MD, "%u: IDs not available, FORWARD %zu oids, block %zu\n", myrank,
+		oids->num_oids, blk_size);
 
 	/** entry->lock will be released in on_refresh() */
 	return -DER_IVCB_FORWARD;
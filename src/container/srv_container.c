@@ -93,6 +93,7 @@ cont_svc_init(struct cont_svc *svc, const uuid_t pool_uuid, uint64_t id,
 	uuid_copy(svc->cs_pool_uuid, pool_uuid);
 	svc->cs_id = id;
 	svc->cs_rsvc = rsvc;
+	D_INIT_LIST_HEAD(&svc->cs_prop_pubs);
 
 	rc = ABT_rwlock_create(&svc->cs_lock);
 	if (rc != ABT_SUCCESS) {
@@ -2378,15 +2379,11 @@ cont_open(struct rdb_tx *tx, struct ds_pool_hdl *pool_hdl, struct cont *cont, cr
 		out_lbl->coo_md_mtime = mdtimes.mtime;
 	}
 
-	/* query the container properties from RDB and update to IV */
-	rc = cont_iv_prop_update(pool_hdl->sph_pool->sp_iv_ns,
-				 cont->c_uuid, prop, true);
+	/*
+	 * The properties are published to IV by cont_op_with_svc() once the
+	 * open is committed, outside of cs_lock, see cont_prop_iv_publish().
+	 */
 	daos_prop_free(prop);
-	if (rc != 0) {
-		DL_ERROR(rc, DF_CONT ": cont_iv_prop_update failed",
-			 DP_CONT(cont->c_svc->cs_pool_uuid, cont->c_uuid));
-		D_GOTO(out, rc);
-	}
 
 	/* update container capa to IV */
 	rc = cont_iv_capability_update(pool_hdl->sph_pool->sp_iv_ns, in->coi_op.ci_hdl,
@@ -5224,8 +5221,8 @@ out:
 	return rc;
 }
 
-void
-ds_cont_prop_iv_update(struct cont_svc *svc, uuid_t cont_uuid)
+static int
+cont_prop_iv_update(struct cont_svc *svc, uuid_t cont_uuid)
 {
 	struct rdb_tx	tx;
 	struct cont	*cont = NULL;
@@ -5238,7 +5235,7 @@ ds_cont_prop_iv_update(struct cont_svc *svc, uuid_t cont_uuid)
 	if (rc != 0) {
 		D_ERROR(DF_UUID": Failed to start rdb tx: %d\n",
 			DP_UUID(svc->cs_pool_uuid), rc);
-		return;
+		return rc;
 	}
 
 	ABT_rwlock_rdlock(svc->cs_lock);
@@ -5269,6 +5266,97 @@ out_lock:
 
 	if (prop != NULL)
 		daos_prop_free(prop);
+	return rc;
+}
+
+/* Property IV publication of one container, shared by concurrent opens */
+struct cont_prop_pub {
+	d_list_t	cpp_link;	/* in cs_prop_pubs */
+	uuid_t		cpp_cont_uuid;
+	ABT_eventual	cpp_eventual;
+	int		cpp_ref;
+	bool		cpp_started;	/* properties being read and published */
+};
+
+static struct cont_prop_pub *
+cont_prop_pub_find(struct cont_svc *svc, uuid_t cont_uuid, bool started)
+{
+	struct cont_prop_pub	*pub;
+
+	d_list_for_each_entry(pub, &svc->cs_prop_pubs, cpp_link) {
+		if (pub->cpp_started == started && uuid_compare(pub->cpp_cont_uuid, cont_uuid) == 0)
+			return pub;
+	}
+	return NULL;
+}
+
+static void
+cont_prop_pub_put(struct cont_prop_pub *pub)
+{
+	D_ASSERT(pub->cpp_ref > 0);
+	if (--pub->cpp_ref == 0) {
+		ABT_eventual_free(&pub->cpp_eventual);
+		D_FREE(pub);
+	}
+}
+
+static int
+cont_prop_pub_wait(struct cont_prop_pub *pub)
+{
+	int	*status;
+	int	 rc;
+
+	pub->cpp_ref++;
+	rc = ABT_eventual_wait(pub->cpp_eventual, (void **)&status);
+	if (rc != ABT_SUCCESS)
+		rc = dss_abterr2der(rc);
+	else
+		rc = *status;
+	cont_prop_pub_put(pub);
+	return rc;
+}
+
+/*
+ * Publish the properties of a container to IV after a handle has been opened.
+ * During an open storm, opens that arrive while a publication is in flight
+ * all join one pending publication, which starts reading the properties only
+ * after the in-flight one is done, hence after all of them were committed.
+ */
+static int
+cont_prop_iv_publish(struct cont_svc *svc, uuid_t cont_uuid)
+{
+	struct cont_prop_pub	*pub;
+	struct cont_prop_pub	*inflight;
+	int			 rc;
+
+	pub = cont_prop_pub_find(svc, cont_uuid, false /* started */);
+	if (pub != NULL)
+		return cont_prop_pub_wait(pub);
+
+	D_ALLOC_PTR(pub);
+	if (pub == NULL)
+		return -DER_NOMEM;
+
+	rc = ABT_eventual_create(sizeof(rc), &pub->cpp_eventual);
+	if (rc != ABT_SUCCESS) {
+		D_FREE(pub);
+		return dss_abterr2der(rc);
+	}
+	uuid_copy(pub->cpp_cont_uuid, cont_uuid);
+	pub->cpp_ref = 1;
+	d_list_add_tail(&pub->cpp_link, &svc->cs_prop_pubs);
+
+	inflight = cont_prop_pub_find(svc, cont_uuid, true /* started */);
+	if (inflight != NULL)
+		cont_prop_pub_wait(inflight);
+
+	pub->cpp_started = true;
+	rc = cont_prop_iv_update(svc, cont_uuid);
+
+	d_list_del(&pub->cpp_link);
+	ABT_eventual_set(pub->cpp_eventual, &rc, sizeof(rc));
+	cont_prop_pub_put(pub);
+	return rc;
 }
 
 static bool
@@ -5462,12 +5550,27 @@ out_lock:
 	ABT_rwlock_unlock(svc->cs_lock);
 	rdb_tx_end(&tx);
 out:
+	/*
+	 * Publish the properties for the opened handle, also on a retried open. The open is
+	 * already committed, so a failure is not returned, the targets fetch the properties
+	 * from the IV root on demand.
+	 */
+	if ((rc == 0) && (opc == CONT_OPEN || opc == CONT_OPEN_BYLABEL)) {
+		uuid_t	*cont_uuid = opc == CONT_OPEN ? &in->ci_uuid : &olbl_out->colo_uuid;
+		int	 rc_pub;
+
+		rc_pub = cont_prop_iv_publish(svc, *cont_uuid);
+		if (rc_pub != 0)
+			DL_WARN(rc_pub, DF_CONT ": failed to publish properties after open",
+				DP_CONT(svc->cs_pool_uuid, *cont_uuid));
+	}
+
 	if ((rc == 0) && !dup_op) {
 		/* Propagate new snapshot list by IV */
 		if (opc == CONT_SNAP_CREATE || opc == CONT_SNAP_DESTROY)
 			ds_cont_update_snap_iv(svc, in->ci_uuid);
 		else if (opc == CONT_PROP_SET || opc == CONT_ACL_UPDATE || opc == CONT_ACL_DELETE)
-			ds_cont_prop_iv_update(svc, in->ci_uuid);
+			cont_prop_iv_update(svc, in->ci_uuid);
 	}
 
 	if ((rc == 0) && !dup_op && fi_pass_noreply) {
@@ -92,6 +92,9 @@ struct cont_svc {
 	/* Manage the EC aggregation epoch */
 	struct sched_request   *cs_ec_leader_ephs_req;
 	d_list_t		cs_ec_agg_list; /* link cont_ec_agg */
+
+	/* Property IV publications shared by concurrent opens */
+	d_list_t		cs_prop_pubs;	/* link cont_prop_pub */
 };
 
 /* Container descriptor */
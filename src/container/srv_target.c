@@ -284,6 +284,31 @@ adjust_upper_bound(struct ds_cont_child *cont, bool vos_agg, uint64_t *upper_bou
 	*upper_bound = min(*upper_bound, cont->sc_ec_agg_eph_boundary);
 }
 
+/* Return the index of the first snapshot in the sorted list that is not less than @epoch */
+static int
+snap_lower_bound(uint64_t *snapshots, int snapshots_nr, daos_epoch_t epoch)
+{
+	int	lo = 0;
+	int	hi = snapshots_nr;
+	int	mid;
+
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		if (snapshots[mid] < epoch)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+static inline uint64_t *
+snap_delete_epc(struct ds_cont_child *cont, bool vos_agg)
+{
+	return vos_agg ? &cont->sc_vos_snap_delete_epc : &cont->sc_ec_snap_delete_epc;
+}
+
 #define MAX_SNAPSHOT_LOCAL	16
 static int
 cont_child_aggregate(struct ds_cont_child *cont, cont_aggregate_cb_t agg_cb,
@@ -293,6 +318,7 @@ cont_child_aggregate(struct ds_cont_child *cont, cont_aggregate_cb_t agg_cb,
 	daos_epoch_range_t	epoch_range;
 	struct sched_request	*req = cont2req(cont, param->ap_vos_agg);
 	uint64_t		hlc = d_hlc_get();
+	uint64_t		*delete_epc = snap_delete_epc(cont, param->ap_vos_agg);
 	uint64_t		change_hlc;
 	uint64_t		interval;
 	uint64_t		snapshots_local[MAX_SNAPSHOT_LOCAL] = { 0 };
@@ -300,15 +326,23 @@ cont_child_aggregate(struct ds_cont_child *cont, cont_aggregate_cb_t agg_cb,
 	int			snapshots_nr;
 	int			tgt_id = dss_get_module_info()->dmi_tgt_id;
 	uint32_t		flags = 0;
+	bool			rescan = false;
 	int			i, rc = 0;
 
 	change_hlc = max(cont->sc_snapshot_delete_hlc,
 			 cont->sc_pool->spc_rebuild_end_hlc);
 	if (param->ap_full_scan_hlc < change_hlc) {
 		/* Snapshot has been deleted or rebuild happens since the last
-		 * aggregation, let's restart from 0.
+		 * aggregation, let's restart from 0. If only snapshots were
+		 * deleted, the aggregated intervals below the lowest deleted
+		 * one are not changed, restart from there instead.
 		 */
-		epoch_min = 0;
+		if (param->ap_full_scan_hlc >= cont->sc_pool->spc_rebuild_end_hlc &&
+		    *delete_epc != 0)
+			epoch_min = min(get_hae(cont, param->ap_vos_agg), *delete_epc);
+		else
+			epoch_min = 0;
+		rescan = true;
 		flags |= VOS_AGG_FL_FORCE_SCAN;
 		D_DEBUG(DB_EPC, "change hlc "DF_X64" > full "DF_X64"\n",
 			change_hlc, param->ap_full_scan_hlc);
@@ -388,8 +422,7 @@ cont_child_aggregate(struct ds_cont_child *cont, cont_aggregate_cb_t agg_cb,
 	}
 
 	/* Find highest snapshot less than last aggregated epoch. */
-	for (i = 0; i < snapshots_nr && snapshots[i] < epoch_min; ++i)
-		;
+	i = snap_lower_bound(snapshots, snapshots_nr, epoch_min);
 
 	if (i == 0)
 		epoch_range.epr_lo = 0;
@@ -430,8 +463,12 @@ cont_child_aggregate(struct ds_cont_child *cont, cont_aggregate_cb_t agg_cb,
 		flags &= ~VOS_AGG_FL_FORCE_MERGE;
 	rc = agg_cb(cont, &epoch_range, flags, param);
 out:
-	if (rc == 0 && epoch_min == 0)
+	if (rc == 0 && (epoch_min == 0 || rescan)) {
 		param->ap_full_scan_hlc = hlc;
+		/* Keep it if more snapshots were deleted during this round. */
+		if (hlc >= cont->sc_snapshot_delete_hlc)
+			*delete_epc = 0;
+	}
 
 	D_DEBUG(DB_EPC, DF_CONT "[%d]: Aggregating finished. %d\n",
 		DP_CONT(cont->sc_pool->spc_uuid, cont->sc_uuid), tgt_id, rc);
@@ -1991,11 +2028,32 @@ struct cont_snap_args {
 	uint64_t	*snapshots;
 };
 
+/*
+ * Return the lowest epoch in the sorted @old list that is not in the sorted @new
+ * list, or 0 if no snapshot is deleted.
+ */
+static uint64_t
+snap_first_deleted(uint64_t *old, int old_nr, uint64_t *new, int new_nr)
+{
+	int	i;
+	int	j;
+
+	for (i = 0, j = 0; i < old_nr; i++) {
+		while (j < new_nr && new[j] < old[i])
+			j++;
+		if (j == new_nr || new[j] != old[i])
+			return old[i];
+	}
+
+	return 0;
+}
+
 static int
 cont_snap_update_one(void *vin)
 {
 	struct cont_snap_args	*args = vin;
 	struct ds_cont_child	*cont;
+	uint64_t		 del_epc;
 	int			 rc;
 
 	/* The container should be exist on the system at this point, if non-exist on this target
@@ -2006,6 +2064,9 @@ cont_snap_update_one(void *vin)
 	if (rc != 0)
 		return rc;
 
+	del_epc = snap_first_deleted(cont->sc_snapshots, cont->sc_snapshots_nr, args->snapshots,
+				     args->snap_count);
+
 	if (args->snap_count == 0) {
 		if (cont->sc_snapshots != NULL) {
 			D_ASSERT(cont->sc_snapshots_nr > 0);
@@ -2026,10 +2087,14 @@ cont_snap_update_one(void *vin)
 	}
 
 	/* Snapshot deleted, reset aggregation lower bound epoch */
-	if (cont->sc_snapshots_nr > args->snap_count) {
+	if (del_epc != 0) {
+		if (cont->sc_vos_snap_delete_epc == 0 || del_epc < cont->sc_vos_snap_delete_epc)
+			cont->sc_vos_snap_delete_epc = del_epc;
+		if (cont->sc_ec_snap_delete_epc == 0 || del_epc < cont->sc_ec_snap_delete_epc)
+			cont->sc_ec_snap_delete_epc = del_epc;
 		cont->sc_snapshot_delete_hlc = d_hlc_get();
-		D_DEBUG(DB_EPC, DF_CONT": Reset aggregation lower bound\n",
-			DP_CONT(args->pool_uuid, args->cont_uuid));
+		D_DEBUG(DB_EPC, DF_CONT": Reset aggregation lower bound to "DF_X64"\n",
+			DP_CONT(args->pool_uuid, args->cont_uuid), del_epc);
 	}
 	cont->sc_snapshots_nr = args->snap_count;
 	cont->sc_aggregation_max = DAOS_EPOCH_MAX;
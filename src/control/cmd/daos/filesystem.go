@@ -50,6 +50,7 @@ type fsCmd struct {
 	DfuseQuery     fsDfuseQueryCmd     `command:"query" description:"Query dfuse for memory usage"`
 	DfuseEvict     fsDfuseEvictCmd     `command:"evict" description:"Evict object from dfuse"`
 	Scan           fsScanCmd           `command:"scan" description:"Scan POSIX container and report statistics"`
+	PromoteDir     fsPromoteDirCmd     `command:"promote-dir" description:"Move a large directory to a wider object class (requires exclusive container access)"`
 }
 
 type fsCopyCmd struct {
@@ -673,3 +674,44 @@ func (cmd *fsScanCmd) Execute(_ []string) error {
 	}
 	return nil
 }
+
+type fsPromoteDirCmd struct {
+	existingContainerCmd
+
+	DfsPath     string       `long:"dfs-path" short:"H" description:"path of the directory relative to the root of the container" required:"1"`
+	ObjectClass ObjClassFlag `long:"oclass" short:"o" description:"new object class of the directory (default: widest class for directories)"`
+}
+
+func (cmd *fsPromoteDirCmd) Execute(_ []string) error {
+	ap, deallocCmdArgs, err := allocCmdArgs(cmd.Logger)
+	if err != nil {
+		return err
+	}
+	defer deallocCmdArgs()
+
+	if err := cmd.resolveContainer(ap); err != nil {
+		return err
+	}
+
+	cleanupPool, err := cmd.connectPool(C.DAOS_PC_RW, ap)
+	if err != nil {
+		return err
+	}
+	defer cleanupPool()
+
+	dfsPath := C.CString(cmd.DfsPath)
+	defer freeString(dfsPath)
+
+	var oclass C.daos_oclass_id_t
+	if cmd.ObjectClass.Set {
+		oclass = C.daos_oclass_id_t(cmd.ObjectClass.Class)
+	}
+
+	rc := C.dfs_dir_promote(cmd.cPoolHandle, &ap.cont_str[0], dfsPath, oclass)
+	if err := dfsError(rc); err != nil {
+		return errors.Wrapf(err, "failed to promote %s", cmd.DfsPath)
+	}
+
+	cmd.Infof("Promoted %s", cmd.DfsPath)
+	return nil
+}
@@ -607,6 +607,68 @@ dtx_aggregation_main(void *arg)
 	dmi->dmi_dtx_agg_req = NULL;
 }
 
+struct dtx_coll_commit_args {
+	struct ds_cont_child	*dcca_cont;
+	struct dtx_coll_entry	*dcca_dce;
+	struct dtx_cos_key	*dcca_dck;
+	int			 dcca_result;
+};
+
+static void
+dtx_coll_commit_ult(void *arg)
+{
+	struct dtx_coll_commit_args	*dcca = arg;
+
+	dcca->dcca_result = dtx_coll_commit(dcca->dcca_cont, dcca->dcca_dce, dcca->dcca_dck, true);
+}
+
+/*
+ * Commit the collective DTX @dce together with other committable collective DTXs. Each one
+ * is committed via its own collective RPC, so run them in parallel ULTs instead of one by
+ * one. The others that fail to be committed will stay in CoS and be retried later.
+ */
+static int
+dtx_coll_commit_batch(struct ds_cont_child *cont, struct dtx_coll_entry *dce)
+{
+	struct dtx_coll_entry		*dces[DTX_COLL_BATCH_MAX - 1];
+	struct dtx_cos_key		 dcks[DTX_COLL_BATCH_MAX - 1];
+	struct dtx_coll_commit_args	 args[DTX_COLL_BATCH_MAX - 1];
+	ABT_thread			 ults[DTX_COLL_BATCH_MAX - 1];
+	int				 cnt;
+	int				 rc;
+	int				 i;
+
+	cnt = dtx_fetch_committable_coll(cont, DTX_COLL_BATCH_MAX - 1, dces, dcks);
+	for (i = 0; i < cnt; i++) {
+		args[i].dcca_cont = cont;
+		args[i].dcca_dce = dces[i];
+		args[i].dcca_dck = &dcks[i];
+		args[i].dcca_result = 0;
+		ults[i] = ABT_THREAD_NULL;
+
+		rc = dss_ult_create(dtx_coll_commit_ult, &args[i], DSS_XS_SELF, 0, 0, &ults[i]);
+		if (rc != 0)
+			dtx_coll_commit_ult(&args[i]);
+	}
+
+	rc = dtx_coll_commit(cont, dce, NULL, true);
+
+	for (i = 0; i < cnt; i++) {
+		if (ults[i] != ABT_THREAD_NULL)
+			ABT_thread_free(&ults[i]);
+
+		if (args[i].dcca_result != 0)
+			D_DEBUG(DB_TRACE, "Fail to commit collective DTX "DF_DTI" in batch: "
+				DF_RC"\n", DP_DTI(&dces[i]->dce_xid), DP_RC(args[i].dcca_result));
+
+		/* Allow others to fetch it again if it is still in CoS. */
+		dtx_cos_coll_done(cont, &dces[i]->dce_xid, &dcks[i]);
+		dtx_coll_entry_put(dces[i]);
+	}
+
+	return rc;
+}
+
 static void
 dtx_batched_commit_one(void *arg)
 {
@@ -641,10 +703,9 @@ dtx_batched_commit_one(void *arg)
 		}
 
 		if (dce != NULL) {
-			/* Currently, commit collective DTX one by one. */
 			D_ASSERT(cnt == 1);
 
-			rc = dtx_coll_commit(cont, dce, NULL, true);
+			rc = dtx_coll_commit_batch(cont, dce);
 		} else {
 			rc = dtx_commit(cont, dtes, NULL, cnt, true);
 		}
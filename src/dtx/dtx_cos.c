@@ -68,7 +68,9 @@ struct dtx_cos_rec_child {
 	uint32_t			 dcrc_expcmt:1,
 					 dcrc_prio:1,
 					 dcrc_reg:1,
-					 dcrc_coll:1; /* For collective DTX. */
+					 dcrc_coll:1, /* For collective DTX. */
+					 /* Being committed via dtx_fetch_committable_coll(). */
+					 dcrc_inflight:1;
 };
 
 struct dtx_cos_rec_bundle {
@@ -407,6 +409,9 @@ dtx_fetch_committable(struct ds_cont_child *cont, uint32_t max_cnt,
 	/* Process collective DXT with higher priority. */
 	if (!d_list_empty(&cont->sc_dtx_coll_list) && oid == NULL) {
 		d_list_for_each_entry(dcrc, &cont->sc_dtx_coll_list, dcrc_gl_committable) {
+			if (dcrc->dcrc_inflight)
+				continue;
+
 			if (epoch >= dcrc->dcrc_epoch &&
 			    (dcrc->dcrc_piggyback_refs == 0 || force)) {
 				if (dcks != NULL) {
@@ -452,7 +457,7 @@ dtx_fetch_committable(struct ds_cont_child *cont, uint32_t max_cnt,
 			continue;
 
 		if (unlikely(dcrc->dcrc_coll)) {
-			if (i > 0)
+			if (i > 0 || dcrc->dcrc_inflight)
 				continue;
 
 			D_FREE(dte_buf);
@@ -493,6 +498,37 @@ dtx_fetch_committable(struct ds_cont_child *cont, uint32_t max_cnt,
 	return i;
 }
 
+/*
+ * Fetch more committable collective DTXs that are not in the current batch. Unlike the
+ * ones returned by dtx_fetch_committable(), they are not linked into the batched list,
+ * so the caller needs to commit them with the returned @dcks. They are marked in-flight
+ * so that no other commit path fetches them meanwhile, the caller must release each of
+ * them via dtx_cos_coll_done() after the commit, whatever the result.
+ */
+int
+dtx_fetch_committable_coll(struct ds_cont_child *cont, uint32_t max_cnt,
+			   struct dtx_coll_entry **dces, struct dtx_cos_key *dcks)
+{
+	struct dtx_cos_rec_child	*dcrc;
+	uint32_t			 i = 0;
+
+	d_list_for_each_entry(dcrc, &cont->sc_dtx_coll_list, dcrc_gl_committable) {
+		if (i >= max_cnt)
+			break;
+
+		if (dcrc->dcrc_piggyback_refs > 0 || dcrc->dcrc_inflight ||
+		    !d_list_empty(&dcrc->dcrc_batched_link))
+			continue;
+
+		dcrc->dcrc_inflight = 1;
+		dcks[i].oid = dcrc->dcrc_ptr->dcr_oid;
+		dcks[i].dkey_hash = dcrc->dcrc_ptr->dcr_dkey_hash;
+		dces[i++] = dtx_coll_entry_get(dcrc->dcrc_dce);
+	}
+
+	return i;
+}
+
 int
 dtx_cos_get_piggyback(struct ds_cont_child *cont, daos_unit_oid_t *oid,
 		      uint64_t dkey_hash, int max, struct dtx_id **dtis)
@@ -630,69 +666,82 @@ dtx_cos_add(struct ds_cont_child *cont, void *entry, daos_unit_oid_t *oid,
 	return rc;
 }
 
-int
-dtx_cos_del(struct ds_cont_child *cont, struct dtx_id *xid,
-	    daos_unit_oid_t *oid, uint64_t dkey_hash, bool demote)
+static struct dtx_cos_rec_child *
+dtx_cos_lookup_child(struct ds_cont_child *cont, struct dtx_id *xid, daos_unit_oid_t *oid,
+		     uint64_t dkey_hash, int *rc)
 {
 	struct dtx_cos_key		 key;
 	d_iov_t				 kiov;
 	d_iov_t				 riov;
 	struct dtx_cos_rec		*dcr;
 	struct dtx_cos_rec_child	*dcrc;
-	int				 found = 0;
-	int				 rc;
 
 	key.oid = *oid;
 	key.dkey_hash = dkey_hash;
 	d_iov_set(&kiov, &key, sizeof(key));
 	d_iov_set(&riov, NULL, 0);
 
-	rc = dbtree_lookup(cont->sc_dtx_cos_hdl, &kiov, &riov);
-	if (rc != 0)
-		goto out;
+	*rc = dbtree_lookup(cont->sc_dtx_cos_hdl, &kiov, &riov);
+	if (*rc != 0)
+		return NULL;
 
 	dcr = (struct dtx_cos_rec *)riov.iov_buf;
 
 	d_list_for_each_entry(dcrc, &dcr->dcr_prio_list, dcrc_lo_link) {
-		if (memcmp(&dcrc->dcrc_dte->dte_xid, xid, sizeof(*xid)) == 0) {
-			if (demote)
-				dtx_cos_demote_one(cont, dcrc);
-			else
-				rc = dtx_cos_del_one(cont, dcrc);
-			D_GOTO(out, found = 1);
-		}
+		if (memcmp(&dcrc->dcrc_dte->dte_xid, xid, sizeof(*xid)) == 0)
+			return dcrc;
 	}
 
 	d_list_for_each_entry(dcrc, &dcr->dcr_reg_list, dcrc_lo_link) {
-		if (memcmp(&dcrc->dcrc_dte->dte_xid, xid, sizeof(*xid)) == 0) {
-			if (demote)
-				dtx_cos_demote_one(cont, dcrc);
-			else
-				rc = dtx_cos_del_one(cont, dcrc);
-			D_GOTO(out, found = 2);
-		}
+		if (memcmp(&dcrc->dcrc_dte->dte_xid, xid, sizeof(*xid)) == 0)
+			return dcrc;
 	}
 
 	d_list_for_each_entry(dcrc, &dcr->dcr_expcmt_list, dcrc_lo_link) {
-		if (memcmp(&dcrc->dcrc_dte->dte_xid, xid, sizeof(*xid)) == 0) {
-			if (demote)
-				dtx_cos_demote_one(cont, dcrc);
-			else
-				rc = dtx_cos_del_one(cont, dcrc);
-			D_GOTO(out, found = 3);
-		}
+		if (memcmp(&dcrc->dcrc_dte->dte_xid, xid, sizeof(*xid)) == 0)
+			return dcrc;
 	}
 
-out:
-	if (found > 0 && !demote)
-		d_tm_dec_gauge(dtx_tls_get()->dt_committable, 1);
+	return NULL;
+}
 
-	if (rc == 0 && found == 0)
-		rc = -DER_NONEXIST;
+int
+dtx_cos_del(struct ds_cont_child *cont, struct dtx_id *xid,
+	    daos_unit_oid_t *oid, uint64_t dkey_hash, bool demote)
+{
+	struct dtx_cos_rec_child	*dcrc;
+	int				 rc;
+
+	dcrc = dtx_cos_lookup_child(cont, xid, oid, dkey_hash, &rc);
+	if (dcrc == NULL)
+		goto out;
 
+	if (demote) {
+		dtx_cos_demote_one(cont, dcrc);
+	} else {
+		rc = dtx_cos_del_one(cont, dcrc);
+		d_tm_dec_gauge(dtx_tls_get()->dt_committable, 1);
+	}
+
+out:
 	return rc == -DER_NONEXIST ? 0 : rc;
 }
 
+/*
+ * Clear the in-flight mark set by dtx_fetch_committable_coll(). The DTX may have been
+ * removed from CoS by the commit or by others, then there is nothing to do.
+ */
+void
+dtx_cos_coll_done(struct ds_cont_child *cont, struct dtx_id *xid, struct dtx_cos_key *dck)
+{
+	struct dtx_cos_rec_child	*dcrc;
+	int				 rc;
+
+	dcrc = dtx_cos_lookup_child(cont, xid, &dck->oid, dck->dkey_hash, &rc);
+	if (dcrc != NULL)
+		dcrc->dcrc_inflight = 0;
+}
+
 uint64_t
 dtx_cos_oldest(struct ds_cont_child *cont)
 {
@@ -186,6 +186,12 @@ extern uint32_t dtx_batched_ult_max;
  */
 #define DTX_COLL_TREE_WIDTH		8
 
+/*
+ * The max count of collective DTXs that the batched commit ULT commits concurrently. Each of
+ * them needs its own collective RPC, committing them together overlaps the network latency.
+ */
+#define DTX_COLL_BATCH_MAX		16
+
 /*
  * If a large transaction has sub-requests to dispatch to a lot of DTX participants,
  * then we may have to split the dispatch process to multiple steps; otherwise, the
@@ -269,6 +275,9 @@ int dtx_fetch_committable(struct ds_cont_child *cont, uint32_t max_cnt,
 			  daos_unit_oid_t *oid, daos_epoch_t epoch, bool force,
 			  struct dtx_entry ***dtes, struct dtx_cos_key **dcks,
 			  struct dtx_coll_entry **p_dce);
+int dtx_fetch_committable_coll(struct ds_cont_child *cont, uint32_t max_cnt,
+			       struct dtx_coll_entry **dces, struct dtx_cos_key *dcks);
+void dtx_cos_coll_done(struct ds_cont_child *cont, struct dtx_id *xid, struct dtx_cos_key *dck);
 int dtx_cos_add(struct ds_cont_child *cont, void *entry, daos_unit_oid_t *oid,
 		uint64_t dkey_hash, daos_epoch_t epoch, uint32_t flags);
 int dtx_cos_del(struct ds_cont_child *cont, struct dtx_id *xid,
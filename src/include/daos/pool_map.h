@@ -264,6 +264,8 @@ int pool_map_comp_cnt(struct pool_map *map);
 
 int  pool_map_create(struct pool_buf *buf, uint32_t version,
 		     struct pool_map **mapp);
+int  pool_map_create_incr(struct pool_map *base, struct pool_buf *buf,
+			  uint32_t version, struct pool_map **mapp);
 void pool_map_addref(struct pool_map *map);
 void pool_map_decref(struct pool_map *map);
 int  pool_map_extend(struct pool_map *map, uint32_t version,
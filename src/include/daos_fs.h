@@ -721,6 +721,33 @@ int
 dfs_iterate(dfs_t *dfs, dfs_obj_t *obj, daos_anchor_t *anchor,
 	    uint32_t *nr, size_t size, dfs_filler_cb_t op, void *arg);
 
+/**
+ * Enumerate the names of the next entries of a directory into a caller provided buffer, with a
+ * single enumeration round trip. Unlike dfs_iterate(), this can run asynchronously so that a
+ * caller can fetch the next batch of names while processing the current one. On completion, the
+ * names are packed back to back in \a sgl (not NUL terminated), entry i being
+ * kds[i].kd_key_len bytes long. Fewer than \a nr entries may be returned before the end of the
+ * directory is reached.
+ *
+ * \param[in]	dfs	Pointer to the mounted file system.
+ * \param[in]	obj	Opened directory object.
+ * \param[in,out]
+ *		anchor	Hash anchor for the next call, as for dfs_iterate(). Updated when the
+ *			operation completes.
+ * \param[in,out]
+ *		nr	[in]: MAX number of entries to enumerate.
+ *			[out]: Actual number of entries enumerated, set on completion.
+ * \param[out]	kds	Array of \a nr key descriptors, one per entry enumerated.
+ * \param[in]	sgl	Buffer for the names.
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		0 on success, errno code on failure.
+ */
+int
+dfs_dir_list_names(dfs_t *dfs, dfs_obj_t *obj, daos_anchor_t *anchor, uint32_t *nr,
+		   daos_key_desc_t *kds, d_sg_list_t *sgl, daos_event_t *ev);
+
 /**
  * Set the readdir/iterate anchor to start from a specific entry name in a directory object. When
  * using the anchor in a readdir call, the iteration will start from the position of that entry.
@@ -787,6 +814,47 @@ int
 dfs_mkdir(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode,
 	  daos_oclass_id_t cid);
 
+/**
+ * Create many directories in the same parent. The entries are inserted with many operations in
+ * flight instead of one round trip per directory, which speeds up populating large directories.
+ * Each directory is created independently; the failure of one does not affect the others.
+ *
+ * \param[in]	dfs	Pointer to the mounted file system.
+ * \param[in]	parent	Opened parent directory object. If NULL, use root obj.
+ * \param[in]	names	Array of \a nr link names of the new dirs.
+ * \param[in]	nr	Number of directories to create.
+ * \param[in]	mode	mkdir mode, shared by all directories.
+ * \param[in]	cid	DAOS object class id (pass 0 for default MAX_RW).
+ * \param[out]	rcs	Array of \a nr per-directory results: 0 on success, errno code on failure
+ *			(EEXIST if the name is already taken).
+ *
+ * \return		0 if the batch was processed (check \a rcs), errno code on failure.
+ */
+int
+dfs_mkdir_batch(dfs_t *dfs, dfs_obj_t *parent, const char **names, uint32_t nr, mode_t mode,
+		daos_oclass_id_t cid, int *rcs);
+
+/**
+ * Create many empty regular files in the same parent, the same way as dfs_mkdir_batch(). The
+ * files are not opened; use dfs_lookup_rel() or dfs_open() to access them afterwards.
+ *
+ * \param[in]	dfs	Pointer to the mounted file system.
+ * \param[in]	parent	Opened parent directory object. If NULL, use root obj.
+ * \param[in]	names	Array of \a nr link names of the new files.
+ * \param[in]	nr	Number of files to create.
+ * \param[in]	mode	Permission bits, shared by all files.
+ * \param[in]	cid	DAOS object class id (pass 0 for default MAX_RW).
+ * \param[in]	chunk_size
+ *			Chunk size of the files (pass 0 for default).
+ * \param[out]	rcs	Array of \a nr per-file results: 0 on success, errno code on failure
+ *			(EEXIST if the name is already taken).
+ *
+ * \return		0 if the batch was processed (check \a rcs), errno code on failure.
+ */
+int
+dfs_create_batch(dfs_t *dfs, dfs_obj_t *parent, const char **names, uint32_t nr, mode_t mode,
+		 daos_oclass_id_t cid, daos_size_t chunk_size, int *rcs);
+
 /**
  * Remove an object from parent directory. If object is a directory and is
  * non-empty; this will fail unless force option is true. If object is a
@@ -1190,6 +1258,27 @@ enum {
 int
 dfs_cont_check(daos_handle_t poh, const char *cont, uint64_t flags, const char *name);
 
+/**
+ * Move a directory that grew large to a new object of a wider object class, so that creates and
+ * lookups in it are spread over more targets. Every entry is copied to the new object with all its
+ * extended attributes, the entry of the directory in its parent is switched to the new object and
+ * the old object is punched.
+ *
+ * Like the checker, this is an offline operation: the container is opened exclusively and the
+ * call fails with EBUSY while the container is open anywhere else (e.g. by a dfuse mount). The root
+ * directory can't be promoted.
+ *
+ * \param[in]	poh	Open pool handle.
+ * \param[in]	cont	POSIX container label.
+ * \param[in]	path	Path of the directory relative to the root of the container.
+ * \param[in]	cid	New object class of the directory (pass 0 for the widest class suggested
+ *			by the "directory:max" hint).
+ *
+ * \return		0 on success, errno code on failure.
+ */
+int
+dfs_dir_promote(daos_handle_t poh, const char *cont, const char *path, daos_oclass_id_t cid);
+
 /**
  * Update a POSIX's container's owner user and/or owner group. This is the same as calling
  * daos_cont_set_owner() but will also update the owner of the root directory in the container.
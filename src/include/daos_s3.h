@@ -668,6 +668,28 @@ int
 ds3_part_set_info(struct ds3_multipart_part_info *info, ds3_part_t *ds3p, ds3_t *ds3,
 		  daos_event_t *ev);
 
+/**
+ * Complete an S3 multipart upload by copying the parts, in the given order, into the object.
+ * The copy of the parts is pipelined inside the library with many reads and writes in flight,
+ * so the caller doesn't need to read every part and write it back.
+ * Any existing content of the object is discarded.
+ *
+ * \param[in]	bucket_name	Name of the bucket.
+ * \param[in]	upload_id	The upload id.
+ * \param[in]	part_nums	Numbers of the parts to concatenate, in object order.
+ * \param[in]	nparts		\a part_nums length in items.
+ * \param[in]	ds3o		Handle of the destination S3 object, opened for write.
+ * \param[in]	ds3b		Pointer to the S3 bucket handle the object belongs to.
+ * \param[in]	ds3		Pointer to the DAOS S3 pool handle to use.
+ * \param[out]	size		(Optional) Size of the resulting object.
+ *
+ * \return		0 on success, -errno code on failure.
+ */
+int
+ds3_upload_complete(const char *bucket_name, const char *upload_id, const uint64_t *part_nums,
+		    uint32_t nparts, ds3_obj_t *ds3o, ds3_bucket_t *ds3b, ds3_t *ds3,
+		    daos_size_t *size);
+
 #if defined(__cplusplus)
 }
 #endif
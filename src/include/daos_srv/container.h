@@ -92,6 +92,13 @@ struct ds_cont_child {
 	 * aggregation needs to be restart from 0.
 	 */
 	uint64_t		sc_snapshot_delete_hlc;
+	/*
+	 * The lowest snapshot epoch deleted since the last successful VOS and EC aggregation
+	 * rescan respectively, 0 if none. Aggregation only needs to restart from the snapshot
+	 * interval that covered it.
+	 */
+	uint64_t		sc_vos_snap_delete_epc;
+	uint64_t		sc_ec_snap_delete_epc;
 
 	/* Upper bound of aggregation epoch, it can be:
 	 *
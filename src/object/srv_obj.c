@@ -5191,12 +5191,18 @@ ds_obj_dtx_leader(struct daos_cpd_args *dca)
 	rc = process_epoch(&dcsh->dcsh_epoch.oe_value,
 			   &dcsh->dcsh_epoch.oe_first,
 			   &dcsh->dcsh_epoch.oe_rpc_flags);
-	if (rc == PE_OK_LOCAL) {
+	if (rc == PE_OK_LOCAL && dcsh->dcsh_mbs != NULL &&
+	    dcsh->dcsh_mbs->dm_flags & DMF_SRDG_REP) {
 		/*
-		 * In this case, writes to local RDGs can use the chosen epoch
-		 * without any uncertainty. This optimization is left to future
-		 * work.
+		 * If all the touched targets are in the redundancy group led by
+		 * current engine, then the epoch chosen here can be used without
+		 * uncertainty, the same as standalone update does. That avoids
+		 * restarting small transactions just because their read sets
+		 * conflict with the uncertainty window. For the DTX across more
+		 * RDGs, the other leaders' clocks still need to be respected.
 		 */
+		dcsh->dcsh_epoch.oe_flags &= ~DTX_EPOCH_UNCERTAIN;
+		dcsh->dcsh_epoch.oe_rpc_flags &= ~ORF_EPOCH_UNCERTAIN;
 	}
 
 	D_ASSERT(dcsh->dcsh_epoch.oe_value != 0);
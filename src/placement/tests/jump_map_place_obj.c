@@ -1689,6 +1689,55 @@ placement_handles_multiple_states_with_addition(void **state)
 	jtc_fini(&ctx);
 }
 
+/*
+ * ------------------------------------------------
+ * Pool map built incrementally from a previous version
+ * ------------------------------------------------
+ */
+static void
+pool_map_created_from_previous_version(void **state)
+{
+	struct jm_test_ctx	 ctx;
+	struct pool_buf		*buf;
+	struct pool_map		*base;
+	struct pool_map		*map;
+	struct pool_target	*target;
+	struct pool_domain	*doms;
+	uint32_t		 dom_id;
+	int			 dom_nr;
+
+	jtc_init_with_layout(&ctx, 3, 1, 4, OC_RP_3G1, g_verbose);
+
+	assert_success(pool_buf_extract(ctx.po_map, &buf));
+	assert_success(pool_map_create(buf, pool_map_get_version(ctx.po_map), &base));
+	pool_buf_free(buf);
+
+	/* only the state of one target changes */
+	jtc_set_status_on_target(&ctx, DOWN, 5);
+	assert_success(pool_buf_extract(ctx.po_map, &buf));
+	assert_success(pool_map_create_incr(base, buf, ctx.ver, &map));
+	pool_buf_free(buf);
+
+	assert_int_equal(pool_map_get_version(map), ctx.ver);
+	assert_int_equal(pool_map_target_nr(map), pool_map_target_nr(base));
+	assert_int_equal(pool_map_find_target(map, 5, &target), 1);
+	assert_int_equal(target->ta_comp.co_status, PO_COMP_ST_DOWN);
+	assert_int_equal(pool_map_find_target(base, 5, &target), 1);
+	assert_int_equal(target->ta_comp.co_status, PO_COMP_ST_UPIN);
+
+	dom_nr = pool_map_find_domain(base, PO_COMP_TP_RANK, PO_COMP_ID_ALL, &doms);
+	assert_true(dom_nr > 0);
+	dom_id = doms[dom_nr - 1].do_comp.co_id;
+	assert_int_equal(pool_map_find_domain(map, PO_COMP_TP_RANK, PO_COMP_ID_ALL, NULL),
+			 dom_nr);
+	assert_int_equal(pool_map_find_domain(map, PO_COMP_TP_RANK, dom_id, &doms), 1);
+	assert_int_equal(doms->do_comp.co_id, dom_id);
+
+	pool_map_decref(map);
+	pool_map_decref(base);
+	jtc_fini(&ctx);
+}
+
 /* The following will test non standard layouts and that:
  * - a layout is able to be created with several different randomly generated
  *   object IDs
@@ -2381,6 +2430,8 @@ static const struct CMUnitTest tests[] = {
 	  placement_handles_multiple_states),
 	T("Placement can handle multiple states (including addition)",
 	  placement_handles_multiple_states_with_addition),
+	T("Pool map is created from the previous version",
+	  pool_map_created_from_previous_version),
 	/* Non-standard system setups*/
 	T("Non-standard system configurations. All healthy",
 	  unbalanced_config),
@@ -615,7 +615,9 @@ process_query_reply(struct dc_pool *pool, struct pool_buf *map_buf,
 	D_DEBUG(DB_MD, DF_UUID": info=%p (pi_bits="DF_X64"), ranks=%p\n",
 		DP_UUID(pool->dp_pool), info, info ? info->pi_bits : 0, ranks);
 
-	rc = pool_map_create(map_buf, map_version, &map);
+	D_RWLOCK_RDLOCK(&pool->dp_map_lock);
+	rc = pool_map_create_incr(pool->dp_map, map_buf, map_version, &map);
+	D_RWLOCK_UNLOCK(&pool->dp_map_lock);
 	if (rc != 0) {
 		D_ERROR("failed to create local pool map: "DF_RC"\n", DP_RC(rc));
 		return rc;
@@ -2192,7 +2194,8 @@ map_refresh_cb(tse_task_t *task, void *varg)
 		goto out;
 	}
 
-	rc = pool_map_create(cb_arg->mrc_map_buf, out->tmo_op.po_map_version, &map);
+	rc = pool_map_create_incr(pool->dp_map, cb_arg->mrc_map_buf, out->tmo_op.po_map_version,
+				  &map);
 	if (rc != 0) {
 		D_ERROR(DF_UUID": failed to create pool map: "DF_RC"\n",
 			DP_UUID(pool->dp_pool), DP_RC(rc));
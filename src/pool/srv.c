@@ -24,6 +24,7 @@
 bool		ec_agg_disabled;
 uint32_t        pw_rf = -1; /* pool wise redundancy factor */
 uint32_t        ps_cache_intvl = 2;  /* pool space cache expiration time, in seconds */
+uint32_t        ps_start_parallel;   /* pools started in parallel, 0 for target count */
 #define PW_RF_DEFAULT (2)
 #define PW_RF_MIN     (0)
 #define PW_RF_MAX     (4)
@@ -86,6 +87,9 @@ init(void)
 	}
 	D_INFO("pool space cache expiration time set to %u seconds\n", ps_cache_intvl);
 
+	d_getenv_uint32_t("DAOS_POOL_START_PARALLEL", &ps_start_parallel);
+	D_INFO("pool start parallelism set to %u (0 for target count)\n", ps_start_parallel);
+
 	ds_pool_rsvc_class_register();
 
 	bio_register_ract_ops(&nvme_reaction_ops);
@@ -19,6 +19,7 @@
 
 extern uint32_t pw_rf;
 extern uint32_t ps_cache_intvl;
+extern uint32_t ps_start_parallel;
 
 /**
  * Global pool metrics
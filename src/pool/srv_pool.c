@@ -2707,13 +2707,87 @@ start_one(uuid_t uuid, void *varg)
 	return 0;
 }
 
+struct pool_start_all_arg {
+	ABT_thread	*psaa_ults;
+	uint32_t	 psaa_nr;
+	uint32_t	 psaa_cur;
+};
+
+static void
+start_one_ult(void *arg)
+{
+	unsigned char *uuid = arg;
+
+	start_one(uuid, NULL /* arg */);
+	D_FREE(uuid);
+}
+
+/*
+ * Start the pool in a separate ULT, so that the pools can be started in
+ * parallel. Wait for the oldest one when there are already psaa_nr pools
+ * being started.
+ */
+static int
+start_one_async(uuid_t uuid, void *varg)
+{
+	struct pool_start_all_arg	*psaa = varg;
+	ABT_thread			*ult;
+	unsigned char			*id;
+	int				 rc;
+
+	ult = &psaa->psaa_ults[psaa->psaa_cur++ % psaa->psaa_nr];
+	if (*ult != ABT_THREAD_NULL)
+		ABT_thread_free(ult);
+
+	D_ALLOC(id, sizeof(uuid_t));
+	if (id == NULL)
+		return start_one(uuid, NULL /* arg */);
+	uuid_copy(id, uuid);
+
+	rc = dss_ult_create(start_one_ult, id, DSS_XS_SYS, 0 /* tgt_idx */, 0 /* stack_size */,
+			    ult);
+	if (rc != 0) {
+		DL_WARN(rc, DF_UUID ": failed to create pool start ULT", DP_UUID(uuid));
+		D_FREE(id);
+		return start_one(uuid, NULL /* arg */);
+	}
+
+	return 0;
+}
+
+/*
+ * Start all local pools. This runs in a ULT created by the pool module setup, after the engine
+ * has already notified daos_server that it is ready, so the rank does not wait for it. Each pool
+ * serves requests as soon as its own ds_pool_start() completes, regardless of the pools still
+ * being started, and there is no separate per-pool readiness to report.
+ */
 static void
 pool_start_all(void *arg)
 {
-	int rc;
+	struct pool_start_all_arg	psaa = {0};
+	int				i;
+	int				rc;
+
+	psaa.psaa_nr = ps_start_parallel != 0 ? ps_start_parallel : dss_tgt_nr;
+	D_ALLOC_ARRAY(psaa.psaa_ults, psaa.psaa_nr);
+	if (psaa.psaa_ults == NULL) {
+		/* Scan the storage and start all pool services one by one. */
+		rc = ds_mgmt_tgt_pool_iterate(start_one, NULL /* arg */);
+		goto out;
+	}
+
+	for (i = 0; i < psaa.psaa_nr; i++)
+		psaa.psaa_ults[i] = ABT_THREAD_NULL;
 
 	/* Scan the storage and start all pool services. */
-	rc = ds_mgmt_tgt_pool_iterate(start_one, NULL /* arg */);
+	rc = ds_mgmt_tgt_pool_iterate(start_one_async, &psaa);
+
+	for (i = 0; i < psaa.psaa_nr; i++) {
+		if (psaa.psaa_ults[i] != ABT_THREAD_NULL)
+			ABT_thread_free(&psaa.psaa_ults[i]);
+	}
+	D_FREE(psaa.psaa_ults);
+out:
 	if (rc != 0)
 		D_ERROR("failed to scan all pool services: "DF_RC"\n",
 			DP_RC(rc));
@@ -1946,7 +1946,17 @@ ds_pool_tgt_map_update(struct ds_pool *pool, struct pool_buf *buf,
 	int		rc = 0;
 
 	if (buf != NULL) {
-		rc = pool_map_create(buf, map_version, &map);
+		struct pool_map *base;
+
+		ABT_rwlock_rdlock(pool->sp_lock);
+		base = pool->sp_map;
+		if (base != NULL)
+			pool_map_addref(base);
+		ABT_rwlock_unlock(pool->sp_lock);
+
+		rc = pool_map_create_incr(base, buf, map_version, &map);
+		if (base != NULL)
+			pool_map_decref(base);
 		if (rc != 0) {
 			D_ERROR(DF_UUID" failed to create pool map: "DF_RC"\n",
 				DP_UUID(pool->sp_uuid), DP_RC(rc));
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
 
+#include <stdlib.h>
 #include <daos/debug.h>
 #include <daos_errno.h>
 #include <daos_security.h>
@@ -167,3 +168,185 @@ get_acl_permissions(struct daos_acl *acl, struct d_ownership *ownership, struct
 
 	return rc;
 }
+
+/* Order named ACEs by principal name, then by their position in the ACL */
+static int
+named_ace_cmp(const void *a, const void *b)
+{
+	const struct daos_ace	*ace_a = *(const struct daos_ace **)a;
+	const struct daos_ace	*ace_b = *(const struct daos_ace **)b;
+	int			 rc;
+
+	rc = strncmp(ace_a->dae_principal, ace_b->dae_principal, DAOS_ACL_MAX_PRINCIPAL_LEN);
+	if (rc != 0)
+		return rc;
+
+	return ace_a < ace_b ? -1 : (ace_a > ace_b ? 1 : 0);
+}
+
+/* Find the first ACE in the ACL for a named principal */
+static struct daos_ace *
+find_named_ace(struct daos_ace **aces, size_t nr, const char *name)
+{
+	size_t	lo = 0;
+	size_t	hi = nr;
+	size_t	mid;
+	int	rc;
+
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		rc = strncmp(aces[mid]->dae_principal, name, DAOS_ACL_MAX_PRINCIPAL_LEN);
+		if (rc < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	if (lo < nr && strncmp(aces[lo]->dae_principal, name, DAOS_ACL_MAX_PRINCIPAL_LEN) == 0)
+		return aces[lo];
+	return NULL;
+}
+
+int
+acl_compile(struct daos_acl *acl, struct acl_compiled **compiled)
+{
+	struct acl_compiled	*cacl;
+	struct daos_ace		*ace;
+	size_t			 users_nr = 0;
+	size_t			 groups_nr = 0;
+
+	D_ALLOC_PTR(cacl);
+	if (cacl == NULL)
+		return -DER_NOMEM;
+
+	for (ace = daos_acl_get_next_ace(acl, NULL); ace != NULL;
+	     ace = daos_acl_get_next_ace(acl, ace)) {
+		if (ace->dae_principal_type == DAOS_ACL_USER)
+			users_nr++;
+		else if (ace->dae_principal_type == DAOS_ACL_GROUP)
+			groups_nr++;
+	}
+
+	if (users_nr > 0) {
+		D_ALLOC_ARRAY(cacl->ac_users, users_nr);
+		if (cacl->ac_users == NULL)
+			goto failed;
+	}
+	if (groups_nr > 0) {
+		D_ALLOC_ARRAY(cacl->ac_groups, groups_nr);
+		if (cacl->ac_groups == NULL)
+			goto failed;
+	}
+
+	for (ace = daos_acl_get_next_ace(acl, NULL); ace != NULL;
+	     ace = daos_acl_get_next_ace(acl, ace)) {
+		switch (ace->dae_principal_type) {
+		case DAOS_ACL_OWNER:
+			if (cacl->ac_owner == NULL)
+				cacl->ac_owner = ace;
+			break;
+		case DAOS_ACL_USER:
+			cacl->ac_users[cacl->ac_users_nr++] = ace;
+			break;
+		case DAOS_ACL_OWNER_GROUP:
+			if (cacl->ac_owner_group == NULL)
+				cacl->ac_owner_group = ace;
+			break;
+		case DAOS_ACL_GROUP:
+			cacl->ac_groups[cacl->ac_groups_nr++] = ace;
+			break;
+		case DAOS_ACL_EVERYONE:
+			if (cacl->ac_everyone == NULL)
+				cacl->ac_everyone = ace;
+			break;
+		default:
+			break;
+		}
+	}
+
+	qsort(cacl->ac_users, cacl->ac_users_nr, sizeof(*cacl->ac_users), named_ace_cmp);
+	qsort(cacl->ac_groups, cacl->ac_groups_nr, sizeof(*cacl->ac_groups), named_ace_cmp);
+
+	*compiled = cacl;
+	return 0;
+
+failed:
+	acl_compiled_free(cacl);
+	return -DER_NOMEM;
+}
+
+void
+acl_compiled_free(struct acl_compiled *compiled)
+{
+	if (compiled == NULL)
+		return;
+
+	D_FREE(compiled->ac_users);
+	D_FREE(compiled->ac_groups);
+	D_FREE(compiled);
+}
+
+static void
+calculate_compiled_acl_perms(struct acl_compiled *cacl, struct d_ownership *ownership,
+			     struct acl_user *user_info, uint64_t *perms)
+{
+	struct daos_ace	*ace;
+	uint64_t	 grp_perms = 0;
+	bool		 found = false;
+	size_t		 i;
+
+	/* Same precedence as calculate_acl_perms() */
+	if (cacl->ac_owner != NULL && acl_user_is_owner(user_info, ownership)) {
+		*perms = cacl->ac_owner->dae_allow_perms;
+		return;
+	}
+
+	ace = find_named_ace(cacl->ac_users, cacl->ac_users_nr, user_info->user);
+	if (ace != NULL) {
+		*perms = ace->dae_allow_perms;
+		return;
+	}
+
+	if (cacl->ac_owner_group != NULL && acl_user_has_group(user_info, ownership->group)) {
+		grp_perms |= cacl->ac_owner_group->dae_allow_perms;
+		found = true;
+	}
+
+	for (i = 0; i < user_info->nr_groups; i++) {
+		ace = find_named_ace(cacl->ac_groups, cacl->ac_groups_nr, user_info->groups[i]);
+		if (ace != NULL) {
+			grp_perms |= ace->dae_allow_perms;
+			found = true;
+		}
+	}
+
+	if (found) {
+		*perms = grp_perms;
+		return;
+	}
+
+	*perms = cacl->ac_everyone != NULL ? cacl->ac_everyone->dae_allow_perms : 0;
+}
+
+int
+get_compiled_acl_permissions(struct acl_compiled *compiled, struct d_ownership *ownership,
+			     struct acl_user *user_info, uint64_t min_owner_perms,
+			     uint64_t *perms, bool *is_owner)
+{
+	D_ASSERT(compiled != NULL);
+	D_ASSERT(ownership != NULL);
+	D_ASSERT(user_info != NULL);
+	D_ASSERT(user_info->user != NULL);
+	D_ASSERT(user_info->groups != NULL || user_info->nr_groups == 0);
+	D_ASSERT(perms != NULL);
+
+	calculate_compiled_acl_perms(compiled, ownership, user_info, perms);
+
+	*is_owner = acl_user_is_owner(user_info, ownership);
+
+	/* Owner may have certain implicit permissions */
+	if (*is_owner)
+		*perms |= min_owner_perms;
+
+	return 0;
+}
@@ -52,4 +52,48 @@ int
 get_acl_permissions(struct daos_acl *acl, struct d_ownership *ownership, struct acl_user *user_info,
 		    uint64_t min_owner_perms, uint64_t *permissions, bool *is_owner);
 
+/**
+ * ACL compiled for fast permission lookups. It refers to the ACEs of the ACL it was compiled
+ * from, so that ACL must outlive it.
+ */
+struct acl_compiled {
+	/* ACEs of the special principals, NULL if not in the ACL */
+	struct daos_ace	 *ac_owner;
+	struct daos_ace	 *ac_owner_group;
+	struct daos_ace	 *ac_everyone;
+	/* Named user and group ACEs, sorted by principal name */
+	struct daos_ace	**ac_users;
+	struct daos_ace	**ac_groups;
+	size_t		  ac_users_nr;
+	size_t		  ac_groups_nr;
+};
+
+/**
+ * Compile a valid ACL into lookup tables indexed by principal.
+ *
+ * \param[in]	acl		Valid ACL to compile
+ * \param[out]	compiled	Newly allocated compiled ACL, freed with acl_compiled_free()
+ *
+ * \return	0		Success
+ *		-DER_NOMEM	Out of memory
+ */
+int
+acl_compile(struct daos_acl *acl, struct acl_compiled **compiled);
+
+/**
+ * Free a compiled ACL.
+ *
+ * \param[in]	compiled	Compiled ACL
+ */
+void
+acl_compiled_free(struct acl_compiled *compiled);
+
+/**
+ * Same as get_acl_permissions(), using an ACL compiled by acl_compile().
+ */
+int
+get_compiled_acl_permissions(struct acl_compiled *compiled, struct d_ownership *ownership,
+			     struct acl_user *user_info, uint64_t min_owner_perms,
+			     uint64_t *permissions, bool *is_owner);
+
 #endif
@@ -37,6 +37,7 @@ fini(void)
 {
 	free(ds_sec_server_socket_path);
 	ds_sec_server_socket_path = NULL;
+	ds_sec_acl_cache_fini();
 	return 0;
 }
 
@@ -333,10 +333,158 @@ filter_pool_capas_based_on_flags(uint64_t flags, uint64_t *capas)
 		*capas = 0;
 }
 
+/*
+ * Compiled ACLs, cached by ACL content. Pool connects and container opens against the same
+ * ACL then skip validating it again and look up the principals in sorted tables instead of
+ * walking every ACE for the user and each of their groups.
+ */
+#define ACL_CACHE_MAX		64
+
+struct acl_cache_entry {
+	d_list_t		 ce_link;
+	uint64_t		 ce_hash;
+	int			 ce_ref;
+	struct daos_acl		*ce_acl;
+	struct acl_compiled	*ce_compiled;
+};
+
+static pthread_mutex_t	acl_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+static D_LIST_HEAD(acl_cache);
+static int		acl_cache_nr;
+
+static void
+acl_cache_entry_free(struct acl_cache_entry *entry)
+{
+	acl_compiled_free(entry->ce_compiled);
+	daos_acl_free(entry->ce_acl);
+	D_FREE(entry);
+}
+
+static struct acl_cache_entry *
+acl_cache_find(struct daos_acl *acl, size_t size, uint64_t hash)
+{
+	struct acl_cache_entry	*entry;
+
+	d_list_for_each_entry(entry, &acl_cache, ce_link) {
+		if (entry->ce_hash == hash && daos_acl_get_size(entry->ce_acl) == size &&
+		    memcmp(entry->ce_acl, acl, size) == 0)
+			return entry;
+	}
+	return NULL;
+}
+
+static void
+acl_cache_put(struct acl_cache_entry *entry)
+{
+	bool	last;
+
+	D_MUTEX_LOCK(&acl_cache_lock);
+	D_ASSERT(entry->ce_ref > 0);
+	last = (--entry->ce_ref == 0);
+	D_MUTEX_UNLOCK(&acl_cache_lock);
+
+	if (last)
+		acl_cache_entry_free(entry);
+}
+
+/* Validate and compile the ACL, or get its compiled copy from the cache */
+static int
+acl_cache_get(struct daos_acl *acl, struct acl_cache_entry **entryp)
+{
+	struct acl_cache_entry	*entry;
+	struct acl_cache_entry	*found;
+	struct acl_cache_entry	*evicted = NULL;
+	size_t			 size;
+	uint64_t		 hash;
+	int			 rc;
+
+	/* Only hash ACLs of sane size, let daos_acl_validate() report the others */
+	if (acl->dal_ver != DAOS_ACL_VERSION || acl->dal_len > DAOS_ACL_MAX_ACE_LEN) {
+		rc = daos_acl_validate(acl);
+		return rc != -DER_SUCCESS ? rc : -DER_INVAL;
+	}
+
+	size = daos_acl_get_size(acl);
+	hash = d_hash_murmur64((unsigned char *)acl, size, 5731);
+
+	D_MUTEX_LOCK(&acl_cache_lock);
+	entry = acl_cache_find(acl, size, hash);
+	if (entry != NULL) {
+		d_list_move(&entry->ce_link, &acl_cache);
+		entry->ce_ref++;
+	}
+	D_MUTEX_UNLOCK(&acl_cache_lock);
+	if (entry != NULL)
+		goto out;
+
+	rc = daos_acl_validate(acl);
+	if (rc != -DER_SUCCESS)
+		return rc;
+
+	D_ALLOC_PTR(entry);
+	if (entry == NULL)
+		return -DER_NOMEM;
+
+	entry->ce_acl = daos_acl_dup(acl);
+	if (entry->ce_acl == NULL) {
+		D_FREE(entry);
+		return -DER_NOMEM;
+	}
+
+	rc = acl_compile(entry->ce_acl, &entry->ce_compiled);
+	if (rc != 0) {
+		acl_cache_entry_free(entry);
+		return rc;
+	}
+	entry->ce_hash = hash;
+	entry->ce_ref = 2; /* 1 for the cache, 1 for the caller */
+
+	D_MUTEX_LOCK(&acl_cache_lock);
+	found = acl_cache_find(acl, size, hash);
+	if (found != NULL) {
+		/* Raced with another compilation of the same ACL */
+		found->ce_ref++;
+	} else {
+		d_list_add(&entry->ce_link, &acl_cache);
+		if (++acl_cache_nr > ACL_CACHE_MAX) {
+			evicted = d_list_entry(acl_cache.prev, struct acl_cache_entry, ce_link);
+			d_list_del(&evicted->ce_link);
+			acl_cache_nr--;
+		}
+	}
+	D_MUTEX_UNLOCK(&acl_cache_lock);
+
+	if (found != NULL) {
+		acl_cache_entry_free(entry);
+		entry = found;
+	}
+	if (evicted != NULL)
+		acl_cache_put(evicted);
+out:
+	*entryp = entry;
+	return 0;
+}
+
+void
+ds_sec_acl_cache_fini(void)
+{
+	struct acl_cache_entry	*entry;
+	struct acl_cache_entry	*tmp;
+
+	D_MUTEX_LOCK(&acl_cache_lock);
+	d_list_for_each_entry_safe(entry, tmp, &acl_cache, ce_link) {
+		d_list_del(&entry->ce_link);
+		acl_cache_nr--;
+		if (--entry->ce_ref == 0)
+			acl_cache_entry_free(entry);
+	}
+	D_MUTEX_UNLOCK(&acl_cache_lock);
+}
+
 static int
-get_sec_capas_for_token(Auth__Token *token, struct d_ownership *ownership, struct daos_acl *acl,
-			uint64_t owner_min_perms, uint64_t (*convert_perms)(uint64_t, bool),
-			uint64_t *capas)
+get_sec_capas_for_token(Auth__Token *token, struct d_ownership *ownership,
+			struct acl_compiled *acl, uint64_t owner_min_perms,
+			uint64_t (*convert_perms)(uint64_t, bool), uint64_t *capas)
 {
 	struct drpc_alloc	alloc = PROTO_ALLOCATOR_INIT(alloc);
 	int			rc;
@@ -372,7 +520,8 @@ get_sec_capas_for_token(Auth__Token *token, struct d_ownership *ownership, struc
 	user_info.groups = groups;
 	user_info.nr_groups = nr_groups;
 
-	rc = get_acl_permissions(acl, ownership, &user_info, owner_min_perms, &perms, &is_owner);
+	rc = get_compiled_acl_permissions(acl, ownership, &user_info, owner_min_perms, &perms,
+					  &is_owner);
 	if (rc != 0) {
 		D_ERROR("failed to get user permissions: "DF_RC"\n", DP_RC(rc));
 		D_GOTO(out, rc);
@@ -465,6 +614,7 @@ ds_sec_pool_get_capabilities(uint64_t flags, d_iov_t *cred,
 	struct drpc_alloc	alloc = PROTO_ALLOCATOR_INIT(alloc);
 	int			rc;
 	Auth__Token		*token;
+	struct acl_cache_entry	*cacl;
 
 	if (cred == NULL || ownership == NULL || acl == NULL ||
 	    capas == NULL) {
@@ -485,7 +635,7 @@ ds_sec_pool_get_capabilities(uint64_t flags, d_iov_t *cred,
 		return rc;
 	}
 
-	rc = daos_acl_validate(acl);
+	rc = acl_cache_get(acl, &cacl);
 	if (rc != -DER_SUCCESS) {
 		DL_ERROR(rc, "Invalid ACL");
 		return rc;
@@ -494,15 +644,17 @@ ds_sec_pool_get_capabilities(uint64_t flags, d_iov_t *cred,
 	rc = ds_sec_validate_credentials(cred, &token);
 	if (rc != 0) {
 		DL_ERROR(rc, "Failed to validate credentials");
-		return rc;
+		goto out_acl;
 	}
 
-	rc = get_sec_capas_for_token(token, ownership, acl, 0 /* no special owner perms */,
-				     pool_capas_from_perms, capas);
+	rc = get_sec_capas_for_token(token, ownership, cacl->ce_compiled,
+				     0 /* no special owner perms */, pool_capas_from_perms, capas);
 	if (rc == 0)
 		filter_pool_capas_based_on_flags(flags, capas);
 
 	auth__token__free_unpacked(token, &alloc.alloc);
+out_acl:
+	acl_cache_put(cacl);
 	return rc;
 }
 
@@ -589,6 +741,7 @@ ds_sec_cont_get_capabilities(uint64_t flags, d_iov_t *cred, struct d_ownership *
 {
 	struct drpc_alloc alloc = PROTO_ALLOCATOR_INIT(alloc);
 	Auth__Token      *token;
+	struct acl_cache_entry *cacl;
 	int               rc;
 	uint64_t          owner_min_perms = CONT_OWNER_MIN_PERMS;
 
@@ -607,31 +760,33 @@ ds_sec_cont_get_capabilities(uint64_t flags, d_iov_t *cred, struct d_ownership *
 		return -DER_INVAL;
 	}
 
-	rc = daos_acl_validate(acl);
-	if (rc != -DER_SUCCESS) {
-		DL_ERROR(rc, "Invalid ACL");
-		return rc;
-	}
-
 	if (cred->iov_buf == NULL) {
 		D_ERROR("Credential data is NULL\n");
 		return -DER_INVAL;
 	}
 
+	rc = acl_cache_get(acl, &cacl);
+	if (rc != -DER_SUCCESS) {
+		DL_ERROR(rc, "Invalid ACL");
+		return rc;
+	}
+
 	rc = unpack_token_from_cred(cred, &token);
 	if (rc != -DER_SUCCESS)
-		return rc;
+		goto out_acl;
 
 	/* The credential has already been validated at pool connect. */
 	if (token == NULL)
-		return -DER_INVAL;
+		D_GOTO(out_acl, rc = -DER_INVAL);
 
-	rc = get_sec_capas_for_token(token, ownership, acl, owner_min_perms, cont_capas_from_perms,
-				     capas);
+	rc = get_sec_capas_for_token(token, ownership, cacl->ce_compiled, owner_min_perms,
+				     cont_capas_from_perms, capas);
 	if (rc == 0)
 		filter_cont_capas_based_on_flags(flags, capas);
 
 	auth__token__free_unpacked(token, &alloc.alloc);
+out_acl:
+	acl_cache_put(cacl);
 	return rc;
 }
 
@@ -61,5 +61,6 @@ extern char *ds_sec_server_socket_path;
 				 CONT_CAPA_EVICT_ALL)
 
 int ds_sec_validate_credentials(d_iov_t *creds, Auth__Token **token);
+void ds_sec_acl_cache_fini(void);
 
 #endif /* __SECURITY_SRV_INTERNAL_H__ */
@@ -1509,6 +1509,51 @@ test_pool_get_capas_grps_beat_everyone(void **state)
 	daos_iov_free(&cred);
 }
 
+static void
+test_pool_get_capas_grps_many_aces(void **state)
+{
+	struct daos_acl		*acl;
+	size_t			num_aces = 200;
+	struct daos_ace		*ace[num_aces];
+	d_iov_t			cred;
+	char			name[DAOS_ACL_MAX_PRINCIPAL_LEN];
+	static const char	*groups[] = { "group17@", "group142@" };
+	size_t			i;
+
+	/* Ownership doesn't match */
+	init_valid_cred(&cred, "someuser@", "somegroup@", groups, 2,
+			TEST_HOST);
+
+	/* Only the two groups of the user grant anything, in reverse name order */
+	for (i = 0; i < num_aces; i++) {
+		snprintf(name, sizeof(name), "group%zu@", num_aces - i);
+		ace[i] = daos_ace_create(DAOS_ACL_GROUP, name);
+		ace[i]->dae_access_types = DAOS_ACL_ACCESS_ALLOW;
+		ace[i]->dae_allow_perms = 0;
+		if (strcmp(name, groups[0]) == 0)
+			ace[i]->dae_allow_perms = DAOS_ACL_PERM_READ;
+		if (strcmp(name, groups[1]) == 0)
+			ace[i]->dae_allow_perms = DAOS_ACL_PERM_WRITE;
+	}
+	acl = daos_acl_create(ace, num_aces);
+
+	expect_pool_capas_with_acl(acl, &cred, DAOS_PC_RW, POOL_CAPA_READ |
+			      POOL_CAPA_CREATE_CONT | POOL_CAPA_DEL_CONT);
+	/* Same ACL again */
+	expect_pool_capas_with_acl(acl, &cred, DAOS_PC_RW, POOL_CAPA_READ |
+			      POOL_CAPA_CREATE_CONT | POOL_CAPA_DEL_CONT);
+	daos_acl_free(acl);
+
+	/* Changed ACL must not reuse the previous result */
+	ace[num_aces - 17]->dae_allow_perms = 0;
+	acl = daos_acl_create(ace, num_aces);
+	expect_pool_capas_with_acl(acl, &cred, DAOS_PC_RO, 0);
+
+	daos_acl_free(acl);
+	free_ace_list(ace, num_aces);
+	daos_iov_free(&cred);
+}
+
 /*
  * Container get capas tests
  */
@@ -2202,6 +2247,7 @@ main(void)
 		ACL_UTEST(test_pool_get_capas_grp_no_match),
 		ACL_UTEST(test_pool_get_capas_grp_check_includes_owner),
 		ACL_UTEST(test_pool_get_capas_grps_beat_everyone),
+		ACL_UTEST(test_pool_get_capas_grps_many_aces),
 		ACL_UTEST(test_cont_get_capas_invalid_flags),
 		ACL_UTEST(test_cont_get_capas_null_inputs),
 		ACL_UTEST(test_cont_get_capas_bad_owner),
@@ -67,3 +67,18 @@ class DaosCoreTestDfs(DaosCoreBase):
         :avocado: tags=DaosCoreTestDfs,test_daos_dfs_sys
         """
         self.run_subtest(os.path.join(self.bin, "dfs_test"))
+
+    def test_daos_ds3(self):
+        """
+        Test Description:
+            Run dfs_test -3
+
+        Use cases:
+            DAOS S3 library unit tests
+
+        :avocado: tags=all,pr,full_regression
+        :avocado: tags=hw,large
+        :avocado: tags=daos_test,dfs_test,dfs
+        :avocado: tags=DaosCoreTestDfs,test_daos_ds3
+        """
+        self.run_subtest(os.path.join(self.bin, "dfs_test"))
@@ -112,7 +112,8 @@ class DaosCoreTestDfuse(TestWithServers):
             '--mmap',
             '--exec',
             '--directory',
-            '--cache'
+            '--cache',
+            '--aio'
         ]
         if use_dfuse:
             parameters.append('--lowfd')
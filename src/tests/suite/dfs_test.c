@@ -18,7 +18,7 @@
  * all will be run if no test is specified. Tests will be run in order
  * so tests that kill nodes must be last.
  */
-#define TESTS "pus"
+#define TESTS "pus3"
 static const char *all_tests = TESTS;
 
 static void
@@ -32,6 +32,7 @@ print_usage(int rank)
 	print_message("dfs_test -p|--parallel\n");
 	print_message("dfs_test -u|--unit\n");
 	print_message("dfs_test -s|--sys\n");
+	print_message("dfs_test -3|--ds3\n");
 	print_message("Default <daos_tests> runs all tests\n=============\n");
 	print_message("dfs_test -E|--exclude TESTS\n");
 	print_message("dfs_test -n|--dmg_config\n");
@@ -67,6 +68,12 @@ run_specified_tests(const char *tests, int rank, int size,
 			daos_test_print(rank, "=====================");
 			nr_failed += run_dfs_sys_unit_test(rank, size);
 			break;
+		case '3':
+			daos_test_print(rank, "\n\n=================");
+			daos_test_print(rank, "DS3 unit tests..");
+			daos_test_print(rank, "=====================");
+			nr_failed += run_ds3_unit_test(rank, size);
+			break;
 
 		default:
 			D_ASSERT(0);
@@ -107,6 +114,7 @@ main(int argc, char **argv)
 		{"parallel",	no_argument,		NULL,	'p'},
 		{"unit",	no_argument,		NULL,	'u'},
 		{"sys",		no_argument,		NULL,	's'},
+		{"ds3",		no_argument,		NULL,	'3'},
 		{NULL,		0,			NULL,	0}
 	};
 
@@ -118,7 +126,7 @@ main(int argc, char **argv)
 
 	memset(tests, 0, sizeof(tests));
 
-	while ((opt = getopt_long(argc, argv, "aE:n:pus",
+	while ((opt = getopt_long(argc, argv, "aE:n:pus3",
 				  long_options, &index)) != -1) {
 		if (strchr(all_tests, opt) != NULL) {
 			tests[ntests] = opt;
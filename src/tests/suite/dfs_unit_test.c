@@ -2820,6 +2820,210 @@ dfs_test_checker(void **state)
 	assert_int_equal(rc, 0);
 }
 
+/** More entries per directory than the checker enumerates and keeps in flight at once */
+#define CHK_NR_FILES	300
+#define CHK_LEAK_STRIDE	50
+#define CHK_NR_LEAKED	(2 * (CHK_NR_FILES / CHK_LEAK_STRIDE) + 1)
+
+static void
+chk_create_files(dfs_t *dfs, dfs_obj_t *dir, int nr, daos_obj_id_t *oids)
+{
+	dfs_obj_t	*file;
+	d_sg_list_t	sgl;
+	d_iov_t		iov;
+	char		name[24];
+	char		buf = 'a';
+	int		i;
+	int		rc;
+
+	d_iov_set(&iov, &buf, 1);
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 1;
+	sgl.sg_iovs = &iov;
+
+	for (i = 0; i < nr; i++) {
+		sprintf(name, "file_%d", i);
+		rc = dfs_open(dfs, dir, name, S_IFREG | S_IWUSR | S_IRUSR, O_RDWR | O_CREAT, OC_S1,
+			      0, NULL, &file);
+		assert_int_equal(rc, 0);
+		/** an object that was never written to is not in the OIT */
+		rc = dfs_write(dfs, file, &sgl, 0, NULL);
+		assert_int_equal(rc, 0);
+		if (oids) {
+			rc = dfs_obj2id(file, &oids[i]);
+			assert_int_equal(rc, 0);
+		}
+		rc = dfs_release(file);
+		assert_int_equal(rc, 0);
+	}
+}
+
+static void
+chk_punch_entry(daos_handle_t oh, const char *name)
+{
+	d_iov_t	dkey;
+	int	rc;
+
+	d_iov_set(&dkey, (void *)name, strlen(name));
+	rc = daos_obj_punch_dkeys(oh, DAOS_TX_NONE, DAOS_COND_PUNCH, 1, &dkey, NULL);
+	assert_rc_equal(rc, 0);
+}
+
+/**
+ * Leak files from two nested directories holding more entries than one batch of the checker, and
+ * a directory whose files must stay reachable through it, then check that the checker only
+ * reports them and relinks exactly those.
+ */
+static void
+dfs_test_checker_nested(void **state)
+{
+	test_arg_t		*arg = *state;
+	dfs_t			*dfs;
+	dfs_obj_t		*dirs[2], *leak_dir, *lf, *obj;
+	daos_obj_id_t		dir_oids[2];
+	daos_obj_id_t		file_oids[2][CHK_NR_FILES];
+	daos_obj_id_t		leaked[CHK_NR_LEAKED];
+	daos_handle_t		coh, oh;
+	daos_anchor_t		anchor = {0};
+	uint64_t		nr_oids = 0;
+	uint32_t		nr_ents;
+	uint32_t		nr_found = 0;
+	struct dirent		ents[16];
+	char			*cname = "cont_chkr_nested";
+	char			path[128];
+	char			name[24];
+	mode_t			mode;
+	int			nr_leaked = 0;
+	int			i, j;
+	int			rc;
+
+	rc = dfs_init();
+	assert_int_equal(rc, 0);
+	rc = dfs_connect(arg->pool.pool_str, arg->group, cname, O_CREAT | O_RDWR, NULL, &dfs);
+	assert_int_equal(rc, 0);
+
+	/** /d0/d1, each with CHK_NR_FILES files, and /d0/d1/leak_dir with a few files */
+	for (i = 0; i < 2; i++) {
+		sprintf(name, "d%d", i);
+		rc = dfs_open(dfs, i ? dirs[0] : NULL, name, S_IFDIR | S_IWUSR | S_IRUSR | S_IXUSR,
+			      O_RDWR | O_CREAT, OC_S1, 0, NULL, &dirs[i]);
+		assert_int_equal(rc, 0);
+		rc = dfs_obj2id(dirs[i], &dir_oids[i]);
+		assert_int_equal(rc, 0);
+		chk_create_files(dfs, dirs[i], CHK_NR_FILES, file_oids[i]);
+	}
+	rc = dfs_open(dfs, dirs[1], "leak_dir", S_IFDIR | S_IWUSR | S_IRUSR | S_IXUSR,
+		      O_RDWR | O_CREAT, OC_S1, 0, NULL, &leak_dir);
+	assert_int_equal(rc, 0);
+	chk_create_files(dfs, leak_dir, 5, NULL);
+	rc = dfs_obj2id(leak_dir, &leaked[nr_leaked++]);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(leak_dir);
+	assert_int_equal(rc, 0);
+	for (i = 0; i < 2; i++) {
+		rc = dfs_release(dirs[i]);
+		assert_int_equal(rc, 0);
+	}
+
+	rc = dfs_disconnect(dfs);
+	assert_int_equal(rc, 0);
+	/** have to call fini to release the cached container handle for the checker to work */
+	rc = dfs_fini();
+	assert_int_equal(rc, 0);
+
+	/** punch the entries of every CHK_LEAK_STRIDE file and of leak_dir, leaking their OIDs */
+	rc = daos_cont_open(arg->pool.poh, cname, DAOS_COO_RW, &coh, NULL, NULL);
+	assert_rc_equal(rc, 0);
+	for (i = 0; i < 2; i++) {
+		rc = daos_obj_open(coh, dir_oids[i], DAOS_OO_RW, &oh, NULL);
+		assert_rc_equal(rc, 0);
+		for (j = 0; j < CHK_NR_FILES; j += CHK_LEAK_STRIDE) {
+			sprintf(name, "file_%d", j);
+			chk_punch_entry(oh, name);
+			leaked[nr_leaked++] = file_oids[i][j];
+		}
+		if (i == 1)
+			chk_punch_entry(oh, "leak_dir");
+		rc = daos_obj_close(oh, NULL);
+		assert_rc_equal(rc, 0);
+	}
+	assert_int_equal(nr_leaked, CHK_NR_LEAKED);
+	rc = daos_cont_close(coh, NULL);
+	assert_rc_equal(rc, 0);
+
+	/** SB + root + 2 dirs with their files + leak_dir with its files */
+	get_nr_oids(arg->pool.poh, cname, &nr_oids);
+	assert_int_equal((int)nr_oids, 2 + 2 * (CHK_NR_FILES + 1) + 1 + 5);
+
+	/** only report the leaked OIDs */
+	rc = dfs_cont_check(arg->pool.poh, cname, DFS_CHECK_PRINT, NULL);
+	assert_int_equal(rc, 0);
+	get_nr_oids(arg->pool.poh, cname, &nr_oids);
+	assert_int_equal((int)nr_oids, 2 + 2 * (CHK_NR_FILES + 1) + 1 + 5);
+
+	/** relink them, adding the lost+found and the tlf directories */
+	rc = dfs_cont_check(arg->pool.poh, cname, DFS_CHECK_PRINT | DFS_CHECK_RELINK, "tlf");
+	assert_int_equal(rc, 0);
+	get_nr_oids(arg->pool.poh, cname, &nr_oids);
+	assert_int_equal((int)nr_oids, 2 + 2 * (CHK_NR_FILES + 1) + 1 + 5 + 2);
+
+	rc = dfs_init();
+	assert_int_equal(rc, 0);
+	rc = dfs_connect(arg->pool.pool_str, arg->group, cname, O_RDWR, NULL, &dfs);
+	assert_int_equal(rc, 0);
+
+	/** every leaked OID is relinked with its type, the files of leak_dir stay under it */
+	for (i = 0; i < nr_leaked; i++) {
+		sprintf(path, "/lost+found/tlf/%"PRIu64".%"PRIu64"", leaked[i].hi, leaked[i].lo);
+		rc = dfs_lookup(dfs, path, O_RDONLY, &obj, &mode, NULL);
+		assert_int_equal(rc, 0);
+		if (i == 0) {
+			assert_true(S_ISDIR(mode));
+			nr_ents = 0;
+			while (!daos_anchor_is_eof(&anchor)) {
+				uint32_t nr = 16;
+
+				rc = dfs_readdir(dfs, obj, &anchor, &nr, ents);
+				assert_int_equal(rc, 0);
+				nr_ents += nr;
+			}
+			assert_int_equal(nr_ents, 5);
+		} else {
+			assert_true(S_ISREG(mode));
+		}
+		rc = dfs_release(obj);
+		assert_int_equal(rc, 0);
+	}
+
+	/** and nothing else is */
+	rc = dfs_lookup(dfs, "/lost+found/tlf", O_RDONLY, &lf, NULL, NULL);
+	assert_int_equal(rc, 0);
+	memset(&anchor, 0, sizeof(anchor));
+	while (!daos_anchor_is_eof(&anchor)) {
+		nr_ents = 16;
+		rc = dfs_readdir(dfs, lf, &anchor, &nr_ents, ents);
+		assert_int_equal(rc, 0);
+		nr_found += nr_ents;
+	}
+	assert_int_equal(nr_found, CHK_NR_LEAKED);
+	rc = dfs_release(lf);
+	assert_int_equal(rc, 0);
+
+	/** the entries that were not punched are untouched */
+	rc = dfs_lookup(dfs, "/d0/d1/file_1", O_RDONLY, &obj, &mode, NULL);
+	assert_int_equal(rc, 0);
+	assert_true(S_ISREG(mode));
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+
+	rc = dfs_disconnect(dfs);
+	assert_int_equal(rc, 0);
+	rc = dfs_destroy(arg->pool.pool_str, arg->group, cname, 0, NULL);
+	assert_rc_equal(rc, 0);
+	rc = dfs_fini();
+	assert_int_equal(rc, 0);
+}
+
 static void
 mwc_sb_root_test(void **state, const char *cname, bool sb_test)
 {
@@ -3360,6 +3564,232 @@ dfs_test_pipeline_find(void **state)
 	assert_int_equal(rc, 0);
 }
 
+static void
+dfs_test_rm_tree(void **state)
+{
+	dfs_obj_t	*top;
+	dfs_obj_t	*sub;
+	dfs_obj_t	*obj;
+	int		nr_dirs = 4;
+	int		nr = 300;
+	char		name[24];
+	char		sub_name[24];
+	int		i, j;
+	int		rc;
+
+	rc = dfs_mkdir(dfs_mt, NULL, "rm_tree", S_IFDIR | S_IWUSR | S_IRUSR, 0);
+	assert_int_equal(rc, 0);
+	rc = dfs_lookup_rel(dfs_mt, NULL, "rm_tree", O_RDWR, &top, NULL, NULL);
+	assert_int_equal(rc, 0);
+
+	/** sub-directories larger than one enumeration batch, plus files and symlinks */
+	for (i = 0; i < nr_dirs; i++) {
+		sprintf(sub_name, "sub_%d", i);
+		rc = dfs_mkdir(dfs_mt, top, sub_name, S_IFDIR | S_IWUSR | S_IRUSR, 0);
+		assert_int_equal(rc, 0);
+		rc = dfs_lookup_rel(dfs_mt, top, sub_name, O_RDWR, &sub, NULL, NULL);
+		assert_int_equal(rc, 0);
+
+		for (j = 0; j < nr; j++) {
+			sprintf(name, "file_%d", j);
+			rc = dfs_open(dfs_mt, sub, name, S_IFREG | S_IWUSR | S_IRUSR,
+				      O_RDWR | O_CREAT, 0, 0, NULL, &obj);
+			assert_int_equal(rc, 0);
+			rc = dfs_release(obj);
+			assert_int_equal(rc, 0);
+		}
+		rc = dfs_mkdir(dfs_mt, sub, "empty", S_IFDIR | S_IWUSR | S_IRUSR, 0);
+		assert_int_equal(rc, 0);
+		rc = dfs_open(dfs_mt, sub, "link", S_IFLNK, O_RDWR | O_CREAT | O_EXCL, 0, 0,
+			      "file_0", &obj);
+		assert_int_equal(rc, 0);
+		rc = dfs_release(obj);
+		assert_int_equal(rc, 0);
+		rc = dfs_release(sub);
+		assert_int_equal(rc, 0);
+	}
+	rc = dfs_release(top);
+	assert_int_equal(rc, 0);
+
+	rc = dfs_remove(dfs_mt, NULL, "rm_tree", false, NULL);
+	assert_int_equal(rc, ENOTEMPTY);
+
+	print_message("Removing tree of %d entries\n", nr_dirs * (nr + 3) + 1);
+	rc = dfs_remove(dfs_mt, NULL, "rm_tree", true, NULL);
+	assert_int_equal(rc, 0);
+
+	rc = dfs_lookup_rel(dfs_mt, NULL, "rm_tree", O_RDONLY, &top, NULL, NULL);
+	assert_int_equal(rc, ENOENT);
+}
+
+static void
+dfs_test_create_batch(void **state)
+{
+	dfs_obj_t	*top;
+	dfs_obj_t	*obj;
+	int		nr = 300;
+	char		**names;
+	int		*rcs;
+	mode_t		mode;
+	int		i;
+	int		rc;
+
+	rc = dfs_mkdir(dfs_mt, NULL, "batch_dir", S_IFDIR | S_IWUSR | S_IRUSR, 0);
+	assert_int_equal(rc, 0);
+	rc = dfs_lookup_rel(dfs_mt, NULL, "batch_dir", O_RDWR, &top, NULL, NULL);
+	assert_int_equal(rc, 0);
+
+	D_ALLOC_ARRAY(names, nr);
+	assert_non_null(names);
+	D_ALLOC_ARRAY(rcs, nr);
+	assert_non_null(rcs);
+	for (i = 0; i < nr; i++) {
+		D_ASPRINTF(names[i], "entry_%d", i);
+		assert_non_null(names[i]);
+	}
+
+	/** more entries than the number of inserts kept in flight */
+	rc = dfs_mkdir_batch(dfs_mt, top, (const char **)names, nr / 2, S_IWUSR | S_IRUSR, 0, rcs);
+	assert_int_equal(rc, 0);
+	for (i = 0; i < nr / 2; i++)
+		assert_int_equal(rcs[i], 0);
+
+	/** the first half already exists, only the second half is created */
+	rc = dfs_create_batch(dfs_mt, top, (const char **)names, nr, S_IWUSR | S_IRUSR, 0, 0, rcs);
+	assert_int_equal(rc, 0);
+	for (i = 0; i < nr; i++)
+		assert_int_equal(rcs[i], i < nr / 2 ? EEXIST : 0);
+
+	for (i = 0; i < nr; i++) {
+		rc = dfs_lookup_rel(dfs_mt, top, names[i], O_RDWR, &obj, &mode, NULL);
+		assert_int_equal(rc, 0);
+		if (i < nr / 2)
+			assert_true(S_ISDIR(mode));
+		else
+			assert_true(S_ISREG(mode));
+		rc = dfs_release(obj);
+		assert_int_equal(rc, 0);
+	}
+
+	rc = dfs_release(top);
+	assert_int_equal(rc, 0);
+	rc = dfs_remove(dfs_mt, NULL, "batch_dir", true, NULL);
+	assert_int_equal(rc, 0);
+
+	for (i = 0; i < nr; i++)
+		D_FREE(names[i]);
+	D_FREE(names);
+	D_FREE(rcs);
+}
+
+static void
+dfs_test_dir_promote(void **state)
+{
+	test_arg_t	*arg = *state;
+	dfs_t		*dfs;
+	dfs_obj_t	*dir;
+	dfs_obj_t	*obj;
+	daos_obj_id_t	oid;
+	int		nr = 300;
+	char		name[24];
+	char		buf[64];
+	daos_size_t	size;
+	char		*cname = "cont_promote";
+	int		i;
+	int		rc;
+
+	rc = dfs_init();
+	assert_int_equal(rc, 0);
+	rc = dfs_connect(arg->pool.pool_str, arg->group, cname, O_CREAT | O_RDWR, NULL, &dfs);
+	assert_int_equal(rc, 0);
+
+	rc = dfs_mkdir(dfs, NULL, "promote_dir", S_IFDIR | S_IWUSR | S_IRUSR, OC_S1);
+	assert_int_equal(rc, 0);
+	rc = dfs_lookup_rel(dfs, NULL, "promote_dir", O_RDWR, &dir, NULL, NULL);
+	assert_int_equal(rc, 0);
+
+	for (i = 0; i < nr; i++) {
+		sprintf(name, "file_%d", i);
+		rc = dfs_open(dfs, dir, name, S_IFREG | S_IWUSR | S_IRUSR, O_RDWR | O_CREAT, 0,
+			      0, NULL, &obj);
+		assert_int_equal(rc, 0);
+		rc = dfs_release(obj);
+		assert_int_equal(rc, 0);
+	}
+	rc = dfs_open(dfs, dir, "link", S_IFLNK, O_RDWR | O_CREAT | O_EXCL, 0, 0, "file_0",
+		      &obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_setxattr(dfs, obj, "user.attr", "val", 4, 0);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(dir);
+	assert_int_equal(rc, 0);
+
+	/** the container is still open through the DFS handle */
+	rc = dfs_dir_promote(arg->pool.poh, cname, "/promote_dir", OC_SX);
+	assert_int_equal(rc, EBUSY);
+
+	rc = dfs_disconnect(dfs);
+	assert_int_equal(rc, 0);
+	/** have to call fini to release the cached container handle for the promotion to work */
+	rc = dfs_fini();
+	assert_int_equal(rc, 0);
+
+	rc = dfs_dir_promote(arg->pool.poh, cname, "/promote_dir", OC_SX);
+	assert_int_equal(rc, 0);
+	/** already in the requested class, nothing to do */
+	rc = dfs_dir_promote(arg->pool.poh, cname, "/promote_dir", OC_SX);
+	assert_int_equal(rc, 0);
+	/** the root OID is fixed */
+	rc = dfs_dir_promote(arg->pool.poh, cname, "/", 0);
+	assert_int_equal(rc, ENOTSUP);
+	rc = dfs_dir_promote(arg->pool.poh, cname, "/promote_dir/file_0", 0);
+	assert_int_equal(rc, ENOTDIR);
+
+	rc = dfs_init();
+	assert_int_equal(rc, 0);
+	rc = dfs_connect(arg->pool.pool_str, arg->group, cname, O_RDWR, NULL, &dfs);
+	assert_int_equal(rc, 0);
+
+	/** a new lookup sees the new object with all entries */
+	rc = dfs_lookup_rel(dfs, NULL, "promote_dir", O_RDWR, &dir, NULL, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_obj2id(dir, &oid);
+	assert_int_equal(rc, 0);
+	assert_int_equal(daos_obj_id2class(oid), OC_SX);
+
+	for (i = 0; i < nr; i++) {
+		sprintf(name, "file_%d", i);
+		rc = dfs_lookup_rel(dfs, dir, name, O_RDONLY, &obj, NULL, NULL);
+		assert_int_equal(rc, 0);
+		rc = dfs_release(obj);
+		assert_int_equal(rc, 0);
+	}
+
+	rc = dfs_lookup_rel(dfs, dir, "link", O_RDONLY | O_NOFOLLOW, &obj, NULL, NULL);
+	assert_int_equal(rc, 0);
+	size = sizeof(buf);
+	rc = dfs_get_symlink_value(obj, buf, &size);
+	assert_int_equal(rc, 0);
+	assert_string_equal(buf, "file_0");
+	size = sizeof(buf);
+	rc = dfs_getxattr(dfs, obj, "user.attr", buf, &size);
+	assert_int_equal(rc, 0);
+	assert_string_equal(buf, "val");
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(dir);
+	assert_int_equal(rc, 0);
+
+	rc = dfs_disconnect(dfs);
+	assert_int_equal(rc, 0);
+	rc = dfs_destroy(arg->pool.pool_str, arg->group, cname, 0, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_fini();
+	assert_int_equal(rc, 0);
+}
+
 static const struct CMUnitTest dfs_unit_tests[] = {
 	{ "DFS_UNIT_TEST1: DFS mount / umount",
 	  dfs_test_mount, async_disable, test_case_teardown},
@@ -3417,6 +3847,14 @@ static const struct CMUnitTest dfs_unit_tests[] = {
 	  dfs_test_pipeline_find, async_disable, test_case_teardown},
 	{ "DFS_UNIT_TEST28: dfs open/lookup flags",
 	  dfs_test_oflags, async_disable, test_case_teardown},
+	{ "DFS_UNIT_TEST29: dfs recursive remove",
+	  dfs_test_rm_tree, async_disable, test_case_teardown},
+	{ "DFS_UNIT_TEST30: dfs batched mkdir and create",
+	  dfs_test_create_batch, async_disable, test_case_teardown},
+	{ "DFS_UNIT_TEST31: dfs directory promotion to a wider object class",
+	  dfs_test_dir_promote, async_disable, test_case_teardown},
+	{ "DFS_UNIT_TEST32: dfs container checker on nested multi-batch directories",
+	  dfs_test_checker_nested, async_disable, test_case_teardown},
 };
 
 static int
@@ -32,13 +32,14 @@
 #include <dirent.h>
 #include <sys/wait.h>
 #include <sys/uio.h>
+#include <libaio.h>
 
 #include <dfuse_ioctl.h>
 
 /* Tests can be run by specifying the appropriate argument for a test or all will be run if no test
  * is specified.
  */
-static const char *all_tests = "ismdlfec";
+static const char *all_tests = "ismdlfeco";
 
 static void
 print_usage()
@@ -57,6 +58,7 @@ print_usage()
 	/* verifyenv is only run by exec test. Should not be executed directly */
 	/* print_message("dfuse_test    --verifyenv\n");                       */
 	print_message("dfuse_test -c|--cache\n");
+	print_message("dfuse_test -o|--aio\n");
 	print_message("Default <dfuse_test> runs all tests\n=============\n");
 	print_message("\n=============================\n");
 }
@@ -410,6 +412,248 @@ do_readv_writev(void **state)
 	assert_return_code(rc, errno);
 }
 
+/* More iovecs than libioil converts on the stack, mixing entries adjacent in memory, which it
+ * merges, with empty and non-adjacent ones.
+ */
+#define VEC_NR 12
+
+void
+do_preadv_pwritev(void **state)
+{
+	int          fd;
+	int          rc;
+	int          root = open(test_dir, O_DIRECTORY);
+	char         src[64];
+	char         other[8];
+	char         expected[sizeof(src) + sizeof(other)];
+	char         dst[sizeof(expected)];
+	char         buf_read[sizeof(expected)];
+	struct iovec iov[VEC_NR];
+	size_t       len = 0;
+	ssize_t      bytes;
+	int          i;
+
+	assert_return_code(root, errno);
+
+	for (i = 0; i < sizeof(src); i++)
+		src[i] = 'a' + i % 26;
+	memset(other, 'Z', sizeof(other));
+
+	/* Adjacent runs of src, broken by empty entries and by a buffer somewhere else */
+	for (i = 0; i < VEC_NR; i++) {
+		if (i % 4 == 3) {
+			iov[i].iov_base = src;
+			iov[i].iov_len  = 0;
+		} else if (i == VEC_NR / 2) {
+			iov[i].iov_base = other;
+			iov[i].iov_len  = sizeof(other);
+		} else {
+			iov[i].iov_base = src + len % sizeof(src);
+			iov[i].iov_len  = 8;
+		}
+		memcpy(expected + len, iov[i].iov_base, iov[i].iov_len);
+		len += iov[i].iov_len;
+	}
+	assert_true(len <= sizeof(expected));
+
+	fd = openat(root, "preadv_pwritev_file", O_RDWR | O_CREAT, S_IWUSR | S_IRUSR);
+	assert_return_code(fd, errno);
+
+	bytes = pwritev(fd, iov, VEC_NR, 0);
+	assert_int_equal(bytes, len);
+
+	bytes = pread(fd, buf_read, sizeof(buf_read), 0);
+	assert_int_equal(bytes, len);
+	assert_memory_equal(buf_read, expected, len);
+
+	/* Read it back into one buffer split into adjacent entries, with empty ones in between */
+	assert_true(len % VEC_NR == 0);
+	memset(dst, 0, sizeof(dst));
+	for (i = 0; i < VEC_NR; i++) {
+		iov[i].iov_base = dst + i * (len / VEC_NR);
+		iov[i].iov_len  = len / VEC_NR;
+		if (i % 5 == 2) {
+			iov[i].iov_len = 0;
+			iov[i - 1].iov_len += len / VEC_NR;
+		}
+	}
+
+	bytes = preadv(fd, iov, VEC_NR, 0);
+	assert_int_equal(bytes, len);
+	assert_memory_equal(dst, expected, len);
+
+	rc = close(fd);
+	assert_return_code(rc, errno);
+
+	rc = unlinkat(root, "preadv_pwritev_file", 0);
+	assert_return_code(rc, errno);
+
+	rc = close(root);
+	assert_return_code(rc, errno);
+}
+
+#define AIO_BLOCK 4096
+#define AIO_NR    4
+
+/* Submit all requests to the aio context and wait for all of them to complete */
+static void
+aio_submit_wait(io_context_t ctx, struct iocb **iocbs, int nr, long *res)
+{
+	struct io_event events[AIO_NR * 2];
+	int             done = 0;
+	int             i;
+	int             rc;
+
+	rc = io_submit(ctx, nr, iocbs);
+	assert_int_equal(rc, nr);
+
+	while (done < nr) {
+		rc = io_getevents(ctx, 1, nr - done, events, NULL);
+		assert_true(rc > 0);
+		for (i = 0; i < rc; i++) {
+			int j;
+
+			for (j = 0; j < nr; j++) {
+				if (events[i].obj == iocbs[j])
+					break;
+			}
+			assert_true(j < nr);
+			res[j] = (long)events[i].res;
+		}
+		done += rc;
+	}
+}
+
+/* libaio on a file in the test directory, intercepted by libpil4dfs if preloaded, and on a file
+ * outside of it in the same context, which is passed through to the kernel.
+ */
+void
+do_libaio(void **state)
+{
+	io_context_t ctx = 0;
+	struct iocb  cbs[AIO_NR * 2];
+	struct iocb *iocbs[AIO_NR * 2];
+	struct iovec iov[2];
+	long         res[AIO_NR * 2];
+	char        *wbuf;
+	char        *rbuf;
+	char         sys_file[] = "/tmp/dfuse_test_aio_XXXXXX";
+	int          root;
+	int          fd;
+	int          sys_fd;
+	int          i;
+	int          rc;
+
+	root = open(test_dir, O_DIRECTORY);
+	assert_return_code(root, errno);
+
+	fd = openat(root, "aio_file", O_RDWR | O_CREAT | O_TRUNC, S_IWUSR | S_IRUSR);
+	assert_return_code(fd, errno);
+
+	sys_fd = mkstemp(sys_file);
+	assert_return_code(sys_fd, errno);
+
+	wbuf = malloc(AIO_BLOCK * AIO_NR);
+	assert_non_null(wbuf);
+	rbuf = malloc(AIO_BLOCK * AIO_NR);
+	assert_non_null(rbuf);
+	for (i = 0; i < AIO_BLOCK * AIO_NR; i++)
+		wbuf[i] = (char)(i % 251);
+
+	rc = io_setup(AIO_NR * 2, &ctx);
+	assert_int_equal(rc, 0);
+
+	/* One write per block, completed out of order is fine */
+	for (i = 0; i < AIO_NR; i++) {
+		io_prep_pwrite(&cbs[i], fd, wbuf + i * AIO_BLOCK, AIO_BLOCK, i * AIO_BLOCK);
+		iocbs[i] = &cbs[i];
+	}
+	aio_submit_wait(ctx, iocbs, AIO_NR, res);
+	for (i = 0; i < AIO_NR; i++)
+		assert_int_equal(res[i], AIO_BLOCK);
+
+	/* Reads must report the bytes actually read, including a short read at the end of file */
+	memset(rbuf, 0, AIO_BLOCK * AIO_NR);
+	for (i = 0; i < AIO_NR; i++) {
+		io_prep_pread(&cbs[i], fd, rbuf + i * AIO_BLOCK, AIO_BLOCK, i * AIO_BLOCK + 1);
+		iocbs[i] = &cbs[i];
+	}
+	aio_submit_wait(ctx, iocbs, AIO_NR, res);
+	for (i = 0; i < AIO_NR - 1; i++)
+		assert_int_equal(res[i], AIO_BLOCK);
+	assert_int_equal(res[AIO_NR - 1], AIO_BLOCK - 1);
+	assert_memory_equal(rbuf, wbuf + 1, AIO_BLOCK * AIO_NR - 1);
+
+	/* Vectored write and read, then fsync */
+	iov[0].iov_base = wbuf + AIO_BLOCK;
+	iov[0].iov_len  = AIO_BLOCK;
+	iov[1].iov_base = wbuf;
+	iov[1].iov_len  = AIO_BLOCK;
+	io_prep_pwritev(&cbs[0], fd, iov, 2, 0);
+	iocbs[0] = &cbs[0];
+	aio_submit_wait(ctx, iocbs, 1, res);
+	assert_int_equal(res[0], AIO_BLOCK * 2);
+
+	memset(rbuf, 0, AIO_BLOCK * AIO_NR);
+	iov[0].iov_base = rbuf + AIO_BLOCK;
+	iov[1].iov_base = rbuf;
+	io_prep_preadv(&cbs[0], fd, iov, 2, 0);
+	aio_submit_wait(ctx, iocbs, 1, res);
+	assert_int_equal(res[0], AIO_BLOCK * 2);
+	assert_memory_equal(rbuf, wbuf, AIO_BLOCK * 2);
+
+	/* Older kernels do not support aio fsync on all filesystems */
+	io_prep_fsync(&cbs[0], fd);
+	aio_submit_wait(ctx, iocbs, 1, res);
+	assert_true(res[0] == 0 || res[0] == -EINVAL);
+
+	/* Requests on both files in the same context */
+	for (i = 0; i < AIO_NR; i++) {
+		io_prep_pwrite(&cbs[i * 2], fd, wbuf + i * AIO_BLOCK, AIO_BLOCK, i * AIO_BLOCK);
+		io_prep_pwrite(&cbs[i * 2 + 1], sys_fd, wbuf + i * AIO_BLOCK, AIO_BLOCK,
+			       i * AIO_BLOCK);
+		iocbs[i * 2]     = &cbs[i * 2];
+		iocbs[i * 2 + 1] = &cbs[i * 2 + 1];
+	}
+	aio_submit_wait(ctx, iocbs, AIO_NR * 2, res);
+	for (i = 0; i < AIO_NR * 2; i++)
+		assert_int_equal(res[i], AIO_BLOCK);
+
+	for (i = 0; i < AIO_NR; i++) {
+		io_prep_pread(&cbs[i * 2], fd, rbuf + i * AIO_BLOCK, AIO_BLOCK, i * AIO_BLOCK);
+		iocbs[i * 2] = &cbs[i * 2];
+	}
+	memset(rbuf, 0, AIO_BLOCK * AIO_NR);
+	aio_submit_wait(ctx, iocbs, AIO_NR * 2, res);
+	for (i = 0; i < AIO_NR * 2; i++)
+		assert_int_equal(res[i], AIO_BLOCK);
+	assert_memory_equal(rbuf, wbuf, AIO_BLOCK * AIO_NR);
+
+	memset(rbuf, 0, AIO_BLOCK * AIO_NR);
+	rc = pread(sys_fd, rbuf, AIO_BLOCK * AIO_NR, 0);
+	assert_int_equal(rc, AIO_BLOCK * AIO_NR);
+	assert_memory_equal(rbuf, wbuf, AIO_BLOCK * AIO_NR);
+
+	rc = io_destroy(ctx);
+	assert_int_equal(rc, 0);
+
+	free(rbuf);
+	free(wbuf);
+
+	rc = close(sys_fd);
+	assert_return_code(rc, errno);
+	rc = unlink(sys_file);
+	assert_return_code(rc, errno);
+
+	rc = close(fd);
+	assert_return_code(rc, errno);
+	rc = unlinkat(root, "aio_file", 0);
+	assert_return_code(rc, errno);
+
+	rc = close(root);
+	assert_return_code(rc, errno);
+}
+
 static bool
 timespec_gt(struct timespec t1, struct timespec t2)
 {
@@ -954,6 +1198,7 @@ run_specified_tests(const char *tests, int *sub_tests, int sub_tests_size)
 			    cmocka_unit_test(do_open),
 			    cmocka_unit_test(do_ioctl),
 			    cmocka_unit_test(do_readv_writev),
+			    cmocka_unit_test(do_preadv_pwritev),
 			};
 			nr_failed += cmocka_run_group_tests(io_tests, NULL, NULL);
 			break;
@@ -1029,6 +1274,16 @@ run_specified_tests(const char *tests, int *sub_tests, int sub_tests_size)
 			nr_failed += cmocka_run_group_tests(cache_tests, NULL, NULL);
 			break;
 
+		case 'o':
+			printf("\n\n=================");
+			printf("dfuse libaio tests");
+			printf("=====================\n");
+			const struct CMUnitTest aio_tests[] = {
+			    cmocka_unit_test(do_libaio),
+			};
+			nr_failed += cmocka_run_group_tests(aio_tests, NULL, NULL);
+			break;
+
 		default:
 			assert_true(0);
 		}
@@ -1058,9 +1313,10 @@ main(int argc, char **argv)
 					       {"exec", no_argument, NULL, 'e'},
 					       {"verifyenv", no_argument, NULL, 't'},
 					       {"cache", no_argument, NULL, 'c'},
+					       {"aio", no_argument, NULL, 'o'},
 					       {NULL, 0, NULL, 0}};
 
-	while ((opt = getopt_long(argc, argv, "aM:imsdlfetc", long_options, &index)) != -1) {
+	while ((opt = getopt_long(argc, argv, "aM:imsdlfetco", long_options, &index)) != -1) {
 		if (strchr(all_tests, opt) != NULL) {
 			tests[ntests] = opt;
 			ntests++;
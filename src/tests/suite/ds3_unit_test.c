@@ -0,0 +1,200 @@
+/**
+ * (C) Copyright 2024 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+#define D_LOGFAC	DD_FAC(tests)
+
+#include <daos_s3.h>
+#include "dfs_test.h"
+
+#define DS3_TEST_BUCKET	"ds3_test_bucket"
+#define DS3_TEST_UPLOAD	"ds3_test_upload"
+#define DS3_TEST_KEY	"ds3_test_mp_obj"
+
+/** DS3 pool handle used for all tests */
+static ds3_t		*ds3;
+
+static char
+part_pattern(uint64_t part_num, daos_size_t off)
+{
+	return (char)((part_num * 31 + off) % 251);
+}
+
+static void
+write_part(uint64_t part_num, daos_size_t size)
+{
+	ds3_part_t	*ds3p;
+	char		*buf;
+	daos_size_t	len = size;
+	daos_size_t	i;
+	int		rc;
+
+	D_ALLOC(buf, size);
+	assert_non_null(buf);
+	for (i = 0; i < size; i++)
+		buf[i] = part_pattern(part_num, i);
+
+	rc = ds3_part_open(DS3_TEST_BUCKET, DS3_TEST_UPLOAD, part_num, true, &ds3p, ds3);
+	assert_int_equal(rc, 0);
+	rc = ds3_part_write(buf, 0, &len, ds3p, ds3, NULL);
+	assert_int_equal(rc, 0);
+	assert_int_equal(len, size);
+	rc = ds3_part_close(ds3p);
+	assert_int_equal(rc, 0);
+	D_FREE(buf);
+}
+
+/**
+ * Complete a multipart upload into an existing, larger object and verify that the object holds
+ * exactly the parts in the requested order.
+ */
+static void
+ds3_test_upload_complete(void **state)
+{
+	test_arg_t				*arg = *state;
+	struct ds3_bucket_info			binfo = {0};
+	struct ds3_multipart_upload_info	uinfo = {0};
+	ds3_bucket_t				*ds3b;
+	ds3_obj_t				*ds3o;
+	/** the first part spans more than one copy chunk of the library */
+	uint64_t				part_nums[] = {3, 1, 2};
+	daos_size_t				part_sizes[] = {17, 5 * 1024 * 1024 + 3,
+								1024 * 1024};
+	daos_size_t				total = 0;
+	daos_size_t				old_size = 8 * 1024 * 1024;
+	daos_size_t				size;
+	daos_size_t				off;
+	char					*buf;
+	char					encoded[] = "ds3";
+	int					i;
+	int					rc;
+
+	if (arg->myrank != 0)
+		return;
+
+	strncpy(binfo.name, DS3_TEST_BUCKET, sizeof(binfo.name) - 1);
+	binfo.encoded        = encoded;
+	binfo.encoded_length = sizeof(encoded);
+	rc = ds3_bucket_create(DS3_TEST_BUCKET, &binfo, NULL, ds3, NULL);
+	assert_int_equal(rc, 0);
+	rc = ds3_bucket_open(DS3_TEST_BUCKET, &ds3b, ds3, NULL);
+	assert_int_equal(rc, 0);
+
+	strncpy(uinfo.upload_id, DS3_TEST_UPLOAD, sizeof(uinfo.upload_id) - 1);
+	strncpy(uinfo.key, DS3_TEST_KEY, sizeof(uinfo.key) - 1);
+	uinfo.encoded        = encoded;
+	uinfo.encoded_length = sizeof(encoded);
+	rc = ds3_upload_init(&uinfo, DS3_TEST_BUCKET, ds3);
+	assert_int_equal(rc, 0);
+
+	for (i = 0; i < ARRAY_SIZE(part_nums); i++) {
+		write_part(part_nums[i], part_sizes[i]);
+		total += part_sizes[i];
+	}
+
+	/** existing object larger than the parts, none of its content should remain */
+	D_ALLOC(buf, old_size);
+	assert_non_null(buf);
+	memset(buf, 0xff, old_size);
+	rc = ds3_obj_create(DS3_TEST_KEY, &ds3o, ds3b);
+	assert_int_equal(rc, 0);
+	size = old_size;
+	rc = ds3_obj_write(buf, 0, &size, ds3b, ds3o, NULL);
+	assert_int_equal(rc, 0);
+	assert_int_equal(size, old_size);
+
+	size = 0;
+	rc = ds3_upload_complete(DS3_TEST_BUCKET, DS3_TEST_UPLOAD, part_nums,
+				 ARRAY_SIZE(part_nums), ds3o, ds3b, ds3, &size);
+	assert_int_equal(rc, 0);
+	assert_int_equal(size, total);
+
+	memset(buf, 0, old_size);
+	size = old_size;
+	rc = ds3_obj_read(buf, 0, &size, ds3b, ds3o, NULL);
+	assert_int_equal(rc, 0);
+	assert_int_equal(size, total);
+
+	off = 0;
+	for (i = 0; i < ARRAY_SIZE(part_nums); i++) {
+		daos_size_t j;
+
+		for (j = 0; j < part_sizes[i]; j++)
+			assert_int_equal(buf[off + j], part_pattern(part_nums[i], j));
+		off += part_sizes[i];
+	}
+
+	/** a missing part fails the upload */
+	part_nums[0] = 4;
+	rc = ds3_upload_complete(DS3_TEST_BUCKET, DS3_TEST_UPLOAD, part_nums,
+				 ARRAY_SIZE(part_nums), ds3o, ds3b, ds3, NULL);
+	assert_int_equal(rc, -ENOENT);
+
+	D_FREE(buf);
+	rc = ds3_obj_close(ds3o);
+	assert_int_equal(rc, 0);
+	rc = ds3_upload_remove(DS3_TEST_BUCKET, DS3_TEST_UPLOAD, ds3);
+	assert_int_equal(rc, 0);
+	rc = ds3_bucket_close(ds3b, NULL);
+	assert_int_equal(rc, 0);
+	rc = ds3_bucket_destroy(DS3_TEST_BUCKET, true, ds3, NULL);
+	assert_int_equal(rc, 0);
+}
+
+static const struct CMUnitTest ds3_unit_tests[] = {
+	{ "DS3_UNIT_TEST1: DS3 multipart upload complete",
+	  ds3_test_upload_complete, async_disable, test_case_teardown},
+};
+
+static int
+ds3_setup(void **state)
+{
+	test_arg_t	*arg;
+	int		rc = 0;
+
+	rc = test_setup(state, SETUP_POOL_CONNECT, true, DEFAULT_POOL_SIZE,
+			0, NULL);
+	if (rc != 0)
+		return rc;
+
+	arg = *state;
+
+	if (arg->myrank == 0) {
+		rc = ds3_init();
+		assert_int_equal(rc, 0);
+		rc = ds3_connect(arg->pool.pool_str, arg->group, &ds3, NULL);
+		assert_int_equal(rc, 0);
+	}
+
+	return rc;
+}
+
+static int
+ds3_teardown(void **state)
+{
+	test_arg_t	*arg = *state;
+	int		rc;
+
+	if (arg->myrank == 0) {
+		rc = ds3_disconnect(ds3, NULL);
+		assert_int_equal(rc, 0);
+		rc = ds3_fini();
+		assert_int_equal(rc, 0);
+	}
+	par_barrier(PAR_COMM_WORLD);
+
+	return test_teardown(state);
+}
+
+int
+run_ds3_unit_test(int rank, int size)
+{
+	int rc = 0;
+
+	par_barrier(PAR_COMM_WORLD);
+	rc = cmocka_run_group_tests_name("DAOS_S3_Unit", ds3_unit_tests, ds3_setup,
+					 ds3_teardown);
+	par_barrier(PAR_COMM_WORLD);
+	return rc;
+}
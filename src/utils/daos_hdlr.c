@@ -15,6 +15,7 @@
 #define ENUM_DESC_BUF		512 /* all keys/records returned by enum */
 #define LIBSERIALIZE		"libdaos_serialize.so"
 #define NUM_SERIALIZE_PROPS	19
+#define FS_COPY_BUF_SIZE	(64 * 1024 * 1024) /* max size of each file copy buffer */
 
 #include <stdio.h>
 #include <dirent.h>
@@ -310,6 +311,53 @@ file_write(struct cmd_args_s *ap, struct file_dfs *file_dfs,
 	return rc;
 }
 
+/*
+ * Start to write the @sgl to the DAOS file at its current offset without waiting for the
+ * completion, so that the caller can read the next chunk in the meantime. The @sgl must be
+ * kept unchanged until file_write_wait() on the same @ev.
+ */
+static int
+file_write_async(struct cmd_args_s *ap, struct file_dfs *file_dfs, dfs_t *dfs,
+		 const char *file, d_sg_list_t *sgl, daos_event_t *ev)
+{
+	int rc;
+
+	rc = daos_event_init(ev, DAOS_HDL_INVAL, NULL);
+	if (rc != 0) {
+		DH_PERROR_DER(ap, rc, "Failed to init event for '%s'", file);
+		return daos_der2errno(rc);
+	}
+
+	rc = dfs_write(dfs, file_dfs->obj, sgl, file_dfs->offset, ev);
+	if (rc != 0) {
+		DH_PERROR_SYS(ap, rc, "Failed to write '%s'", file);
+		daos_event_fini(ev);
+		return rc;
+	}
+
+	/* update file pointer with number of bytes being written */
+	file_dfs->offset += sgl->sg_iovs[0].iov_len;
+	return 0;
+}
+
+static int
+file_write_wait(struct cmd_args_s *ap, const char *file, daos_event_t *ev)
+{
+	bool	flag = false;
+	int	rc;
+
+	rc = daos_event_test(ev, DAOS_EQ_WAIT, &flag);
+	if (rc == 0)
+		rc = ev->ev_error;
+	else
+		rc = daos_der2errno(rc);
+	daos_event_fini(ev);
+
+	if (rc != 0)
+		DH_PERROR_SYS(ap, rc, "Failed to write '%s'", file);
+	return rc;
+}
+
 int
 file_open(struct cmd_args_s *ap, struct file_dfs *file_dfs,
 	  const char *file, int flags, ...)
@@ -563,10 +611,17 @@ fs_copy_file(struct cmd_args_s *ap, struct file_dfs *src_file_dfs, struct file_d
 	int dst_flags		= O_CREAT | O_TRUNC | O_WRONLY;
 	mode_t tmp_mode_file	= S_IRUSR | S_IWUSR;
 	int rc;
+	int rc2;
 	uint64_t file_length	= src_stat->st_size;
 	uint64_t total_bytes	= 0;
-	uint64_t buf_size	= 64 * 1024 * 1024;
-	void *buf		= NULL;
+	uint64_t buf_size	= FS_COPY_BUF_SIZE;
+	void *bufs[2]		= {NULL, NULL};
+	int cur			= 0;
+	dfs_t *dst_dfs		= NULL;
+	daos_event_t ev;
+	d_sg_list_t sgl;
+	d_iov_t iov;
+	bool inflight		= false;
 
 	/* Open source file */
 	rc = file_open(ap, src_file_dfs, src_path, src_flags);
@@ -578,10 +633,33 @@ fs_copy_file(struct cmd_args_s *ap, struct file_dfs *src_file_dfs, struct file_d
 	if (rc != 0)
 		D_GOTO(out_src_file, rc = daos_errno2der(rc));
 
+	/* Do not allocate more than the file size, most files in a large tree are small. */
+	if (file_length < buf_size)
+		buf_size = file_length;
+
 	/* Allocate read/write buffer */
-	D_ALLOC(buf, buf_size);
-	if (buf == NULL)
-		D_GOTO(out_dst_file, rc = -DER_NOMEM);
+	if (buf_size > 0) {
+		D_ALLOC_NZ(bufs[0], buf_size);
+		if (bufs[0] == NULL)
+			D_GOTO(out_dst_file, rc = -DER_NOMEM);
+	}
+
+	/*
+	 * If the destination is DAOS and the file needs more than one chunk, then write each
+	 * chunk asynchronously while reading the next chunk into the other buffer.
+	 */
+	if (dst_file_dfs->type == DAOS && file_length > buf_size) {
+		D_ALLOC_NZ(bufs[1], buf_size);
+		if (bufs[1] == NULL)
+			D_GOTO(out_buf, rc = -DER_NOMEM);
+
+		rc = dfs_sys2base(dst_file_dfs->dfs_sys, &dst_dfs);
+		if (rc != 0) {
+			rc = daos_errno2der(rc);
+			DH_PERROR_DER(ap, rc, "Failed to get DFS from DFS sys");
+			D_GOTO(out_buf, rc);
+		}
+	}
 
 	/* read from source file, then write to dest file */
 	while (total_bytes < file_length) {
@@ -590,21 +668,58 @@ fs_copy_file(struct cmd_args_s *ap, struct file_dfs *src_file_dfs, struct file_d
 
 		if (bytes_left < buf_size)
 			left_to_read = (size_t)bytes_left;
-		rc = file_read(ap, src_file_dfs, src_path, buf, &left_to_read);
+		rc = file_read(ap, src_file_dfs, src_path, bufs[cur], &left_to_read);
 		if (rc != 0) {
 			rc = daos_errno2der(rc);
 			DH_PERROR_DER(ap, rc, "File read failed");
 			D_GOTO(out_buf, rc);
 		}
-		ssize_t bytes_to_write = left_to_read;
 
-		rc = file_write(ap, dst_file_dfs, dst_path, buf, &bytes_to_write);
+		if (inflight) {
+			inflight = false;
+			rc = file_write_wait(ap, dst_path, &ev);
+			if (rc != 0) {
+				rc = daos_errno2der(rc);
+				DH_PERROR_DER(ap, rc, "File write failed");
+				D_GOTO(out_buf, rc);
+			}
+		}
+
+		if (dst_dfs != NULL) {
+			sgl.sg_nr = 1;
+			sgl.sg_nr_out = 0;
+			sgl.sg_iovs = &iov;
+			d_iov_set(&iov, bufs[cur], left_to_read);
+
+			rc = file_write_async(ap, dst_file_dfs, dst_dfs, dst_path, &sgl, &ev);
+			if (rc != 0) {
+				rc = daos_errno2der(rc);
+				DH_PERROR_DER(ap, rc, "File write failed");
+				D_GOTO(out_buf, rc);
+			}
+			inflight = true;
+			cur ^= 1;
+		} else {
+			ssize_t bytes_to_write = left_to_read;
+
+			rc = file_write(ap, dst_file_dfs, dst_path, bufs[cur], &bytes_to_write);
+			if (rc != 0) {
+				rc = daos_errno2der(rc);
+				DH_PERROR_DER(ap, rc, "File write failed");
+				D_GOTO(out_buf, rc);
+			}
+		}
+		total_bytes += left_to_read;
+	}
+
+	if (inflight) {
+		inflight = false;
+		rc = file_write_wait(ap, dst_path, &ev);
 		if (rc != 0) {
 			rc = daos_errno2der(rc);
 			DH_PERROR_DER(ap, rc, "File write failed");
 			D_GOTO(out_buf, rc);
 		}
-		total_bytes += left_to_read;
 	}
 
 	/* set perms on destination to original source perms */
@@ -617,7 +732,14 @@ fs_copy_file(struct cmd_args_s *ap, struct file_dfs *src_file_dfs, struct file_d
 	}
 
 out_buf:
-	D_FREE(buf);
+	/* the buffer cannot be released until the in-flight write completes */
+	if (inflight) {
+		rc2 = file_write_wait(ap, dst_path, &ev);
+		if (rc == 0 && rc2 != 0)
+			rc = daos_errno2der(rc2);
+	}
+	D_FREE(bufs[0]);
+	D_FREE(bufs[1]);
 out_dst_file:
 	file_close(ap, dst_file_dfs, dst_path);
 out_src_file:
@@ -944,6 +944,121 @@ io_oi_test(void **state)
 	assert_rc_equal(rc, 0);
 }
 
+#define OI_BLOOM_TEST_OIDS	64
+
+/* Look up \a oid and check whether the bloom filter skipped the tree lookup */
+static void
+oi_bloom_lookup(struct vos_container *cont, daos_unit_oid_t oid, int exp_rc, bool *skipped)
+{
+	struct vos_obj_df	*obj;
+	uint64_t		 tree = cont->vc_oi_tree_lookups;
+	uint64_t		 neg = cont->vc_oi_bloom_neg;
+	uint64_t		 fp = cont->vc_oi_bloom_fp;
+	int			 rc;
+
+	rc = vos_oi_find(cont, oid, &obj, NULL);
+	assert_rc_equal(rc, exp_rc);
+
+	if (cont->vc_oi_bloom_neg != neg) {
+		/* A definite negative never walks the tree */
+		assert_int_equal(cont->vc_oi_bloom_neg, neg + 1);
+		assert_int_equal(cont->vc_oi_tree_lookups, tree);
+		assert_int_equal(cont->vc_oi_bloom_fp, fp);
+		assert_rc_equal(exp_rc, -DER_NONEXIST);
+		*skipped = true;
+	} else {
+		assert_int_equal(cont->vc_oi_tree_lookups, tree + 1);
+		assert_int_equal(cont->vc_oi_bloom_fp, exp_rc == 0 ? fp : fp + 1);
+		*skipped = false;
+	}
+}
+
+static void
+io_oi_bloom_test(void **state)
+{
+	struct io_test_args	*arg = *state;
+	struct vos_obj_df	*obj;
+	struct vos_container	*cont;
+	daos_unit_oid_t		 oids[OI_BLOOM_TEST_OIDS];
+	daos_unit_oid_t		 oid;
+	uint64_t		 neg;
+	bool			 skipped;
+	int			 i;
+	int			 rc;
+
+	cont = vos_hdl2cont(arg->ctx.tc_co_hdl);
+	assert_ptr_not_equal(cont, NULL);
+
+	vos_oi_bloom_enabled = true;
+	cont->vc_oi_bloom_ready = 0;
+
+	rc = umem_tx_begin(vos_cont2umm(cont), NULL);
+	assert_rc_equal(rc, 0);
+	for (i = 0; i < OI_BLOOM_TEST_OIDS; i++) {
+		oids[i] = gen_oid(arg->otype);
+		rc = vos_oi_find_alloc(cont, oids[i], 1, true, &obj, NULL);
+		assert_rc_equal(rc, 0);
+	}
+	rc = umem_tx_end(vos_cont2umm(cont), 0);
+	assert_rc_equal(rc, 0);
+	assert_true(cont->vc_oi_bloom_ready);
+
+	/* No false negative for objects added after the filter was built */
+	for (i = 0; i < OI_BLOOM_TEST_OIDS; i++) {
+		oi_bloom_lookup(cont, oids[i], 0, &skipped);
+		assert_false(skipped);
+	}
+
+	/* Unknown objects are mostly answered by the filter, the rest are false positives */
+	neg = 0;
+	for (i = 0; i < OI_BLOOM_TEST_OIDS; i++) {
+		oid = dts_unit_oid_gen(arg->otype, 0);
+		oi_bloom_lookup(cont, oid, -DER_NONEXIST, &skipped);
+		if (skipped)
+			neg++;
+	}
+	assert_true(neg > OI_BLOOM_TEST_OIDS / 2);
+
+	/* Deleted objects stay in the filter, they must be found by the tree lookup */
+	rc = umem_tx_begin(vos_cont2umm(cont), NULL);
+	assert_rc_equal(rc, 0);
+	for (i = 0; i < OI_BLOOM_TEST_OIDS; i += 2) {
+		rc = vos_oi_delete(cont, oids[i], false);
+		assert_rc_equal(rc, 0);
+	}
+	rc = umem_tx_end(vos_cont2umm(cont), 0);
+	assert_rc_equal(rc, 0);
+
+	for (i = 0; i < OI_BLOOM_TEST_OIDS; i++) {
+		oi_bloom_lookup(cont, oids[i], i % 2 == 0 ? -DER_NONEXIST : 0, &skipped);
+		assert_false(skipped);
+	}
+
+	/* Rebuilt filter must contain all of the remaining objects, and re-inserted ones */
+	cont->vc_oi_bloom_ready = 0;
+	for (i = 1; i < OI_BLOOM_TEST_OIDS; i += 2) {
+		oi_bloom_lookup(cont, oids[i], 0, &skipped);
+		assert_false(skipped);
+	}
+
+	rc = umem_tx_begin(vos_cont2umm(cont), NULL);
+	assert_rc_equal(rc, 0);
+	for (i = 0; i < OI_BLOOM_TEST_OIDS; i += 2) {
+		rc = vos_oi_find_alloc(cont, oids[i], 2, true, &obj, NULL);
+		assert_rc_equal(rc, 0);
+	}
+	rc = umem_tx_end(vos_cont2umm(cont), 0);
+	assert_rc_equal(rc, 0);
+
+	for (i = 0; i < OI_BLOOM_TEST_OIDS; i++) {
+		oi_bloom_lookup(cont, oids[i], 0, &skipped);
+		assert_false(skipped);
+	}
+
+	vos_oi_bloom_enabled = false;
+	cont->vc_oi_bloom_ready = 0;
+}
+
 static void
 io_obj_cache_test(void **state)
 {
@@ -2428,6 +2543,82 @@ io_fetch_hole(void **state)
 	assert_memory_equal(ground_truth, fetch_buf, 3 * 1024);
 }
 
+#define RECX_COMBINE_NR		3
+#define RECX_COMBINE_SIZE	512
+
+static void
+io_recx_combine(void **state)
+{
+	struct io_test_args	*arg = *state;
+	vos_iter_param_t	 param;
+	d_iov_t			 val_iov;
+	daos_key_t		 dkey;
+	daos_key_t		 akey;
+	daos_recx_t		 rexs[RECX_COMBINE_NR];
+	daos_iod_t		 iod;
+	d_sg_list_t		 sgl;
+	char			 dkey_buf[UPDATE_DKEY_SIZE];
+	char			 akey_buf[UPDATE_AKEY_SIZE];
+	char			 update_buf[RECX_COMBINE_NR * RECX_COMBINE_SIZE];
+	char			 fetch_buf[RECX_COMBINE_NR * RECX_COMBINE_SIZE];
+	unsigned long		 saved_flags = arg->ta_flags;
+	int			 recs = 0;
+	int			 i;
+	int			 rc;
+
+	memset(&iod, 0, sizeof(iod));
+	memset(&sgl, 0, sizeof(sgl));
+	memset(&param, 0, sizeof(param));
+
+	arg->oid = gen_oid(arg->otype);
+	vts_key_gen(&dkey_buf[0], arg->dkey_size, true, arg);
+	vts_key_gen(&akey_buf[0], arg->akey_size, false, arg);
+	set_iov(&dkey, &dkey_buf[0], is_daos_obj_type_set(arg->otype, DAOS_OT_DKEY_UINT64));
+	set_iov(&akey, &akey_buf[0], is_daos_obj_type_set(arg->otype, DAOS_OT_AKEY_UINT64));
+
+	/* Adjacent recxs in one update are stored as one extent */
+	for (i = 0; i < RECX_COMBINE_NR; i++) {
+		rexs[i].rx_idx = i * RECX_COMBINE_SIZE;
+		rexs[i].rx_nr = RECX_COMBINE_SIZE;
+	}
+
+	iod.iod_type = DAOS_IOD_ARRAY;
+	iod.iod_size = 1;
+	iod.iod_name = akey;
+	iod.iod_recxs = rexs;
+	iod.iod_nr = RECX_COMBINE_NR;
+
+	dts_buf_render(&update_buf[0], sizeof(update_buf));
+	d_iov_set(&val_iov, &update_buf[0], sizeof(update_buf));
+	sgl.sg_iovs = &val_iov;
+	sgl.sg_nr = 1;
+
+	rc = vos_obj_update(arg->ctx.tc_co_hdl, arg->oid, 1, 0, 0, &dkey, 1, &iod, NULL, &sgl);
+	assert_rc_equal(rc, 0);
+
+	/* Fetch the whole range back as a single recx */
+	rexs[0].rx_nr = RECX_COMBINE_NR * RECX_COMBINE_SIZE;
+	iod.iod_nr = 1;
+	memset(fetch_buf, 0, sizeof(fetch_buf));
+	d_iov_set(&val_iov, &fetch_buf[0], sizeof(fetch_buf));
+	rc = vos_obj_fetch(arg->ctx.tc_co_hdl, arg->oid, 1, 0, &dkey, 1, &iod, &sgl);
+	assert_rc_equal(rc, 0);
+	assert_memory_equal(update_buf, fetch_buf, sizeof(fetch_buf));
+
+	param.ip_hdl = arg->ctx.tc_co_hdl;
+	param.ip_oid = arg->oid;
+	param.ip_dkey = dkey;
+	param.ip_epr.epr_lo = 0;
+	param.ip_epr.epr_hi = DAOS_EPOCH_MAX;
+	param.ip_epc_expr = VOS_IT_EPC_RE;
+
+	arg->ta_flags |= TF_REC_EXT;
+	rc = io_recx_iterate(arg, &param, &akey, 0, &recs, false);
+	arg->ta_flags = saved_flags;
+	assert_rc_equal(rc, 0);
+	assert_int_equal(recs, vos_recx_combine ? 1 : RECX_COMBINE_NR);
+}
+
 static void
 io_pool_overflow_test(void **state)
 {
@@ -3035,6 +3226,7 @@ static const struct CMUnitTest io_tests[] = {
     {"VOS206: Simple scatter-gather list test, multiple update buffers", io_sgl_update, NULL, NULL},
     {"VOS207: Simple scatter-gather list test, multiple fetch buffers", io_sgl_fetch, NULL, NULL},
     {"VOS208: Extent hole test", io_fetch_hole, NULL, NULL},
+    {"VOS208.1: Adjacent recxs stored as one extent", io_recx_combine, NULL, NULL},
     {"VOS220: 100K update/fetch/verify test", io_multiple_dkey, NULL, NULL},
     {"VOS222: overwrite test", io_idx_overwrite, NULL, NULL},
     {"VOS245.0: Object iter test (for oid)", oid_iter_test, oid_iter_test_setup, NULL},
@@ -3056,6 +3248,7 @@ static const struct CMUnitTest io_tests[] = {
 
 static const struct CMUnitTest int_tests[] = {
     {"VOS201: VOS object IO index", io_oi_test, NULL, NULL},
+    {"VOS201.1: VOS object index bloom filter", io_oi_bloom_test, NULL, NULL},
     {"VOS202: VOS object cache test", io_obj_cache_test, NULL, NULL},
     {"VOS300.1: Test key query punch with subsequent update", io_query_key_punch_update, NULL,
      NULL},
@@ -698,6 +698,12 @@ vos_mod_init(void)
 	d_getenv_bool("DAOS_SKIP_OLD_PARTIAL_DTX", &vos_skip_old_partial_dtx);
 	D_INFO("%s old partial committed DTX record\n", vos_skip_old_partial_dtx ? "Skip" : "Keep");
 
+	d_getenv_bool("DAOS_VOS_OI_BLOOM", &vos_oi_bloom_enabled);
+	D_INFO("OI bloom filter is %s\n", vos_oi_bloom_enabled ? "enabled" : "disabled");
+
+	d_getenv_bool("DAOS_VOS_RECX_COMBINE", &vos_recx_combine);
+	D_INFO("Adjacent recx combining is %s\n", vos_recx_combine ? "enabled" : "disabled");
+
 	return rc;
 }
 
@@ -712,7 +718,8 @@ vos_metrics_count(void)
 {
 	return vea_metrics_count() +
 	       (sizeof(struct vos_agg_metrics) + sizeof(struct vos_space_metrics) +
-		sizeof(struct vos_chkpt_metrics)) / sizeof(struct d_tm_node_t *);
+		sizeof(struct vos_chkpt_metrics) + sizeof(struct vos_oi_metrics)) /
+		   sizeof(struct d_tm_node_t *);
 }
 
 static void
@@ -892,6 +899,9 @@ vos_metrics_alloc(const char *path, int tgt_id)
 	/* Initialize metrics for WAL */
 	vos_wal_metrics_init(&vp_metrics->vp_wal_metrics, path, tgt_id);
 
+	/* Initialize metrics for OI lookup */
+	vos_oi_metrics_init(&vp_metrics->vp_oi_metrics, path, tgt_id);
+
 	return vp_metrics;
 }
 
@@ -207,6 +207,7 @@ cont_free_internal(struct vos_container *cont)
 	D_ASSERT(d_list_empty(&cont->vc_dtx_act_list));
 
 	dbtree_close(cont->vc_btr_hdl);
+	D_FREE(cont->vc_oi_bloom);
 
 	if (!d_list_empty(&cont->vc_gc_link))
 		d_list_del(&cont->vc_gc_link);
@@ -145,6 +145,8 @@ enum {
 extern unsigned int vos_agg_nvme_thresh;
 extern bool vos_dkey_punch_propagate;
 extern bool vos_skip_old_partial_dtx;
+extern bool vos_oi_bloom_enabled;
+extern bool vos_recx_combine;
 
 static inline uint32_t vos_byte2blkcnt(uint64_t bytes)
 {
@@ -244,6 +246,15 @@ struct vos_wal_metrics {
 
 void vos_wal_metrics_init(struct vos_wal_metrics *vw_metrics, const char *path, int tgt_id);
 
+/* VOS Pool metrics for object index lookup */
+struct vos_oi_metrics {
+	struct d_tm_node_t *vom_lookups;   /* OI lookups */
+	struct d_tm_node_t *vom_bloom_neg; /* Lookups answered by bloom filter */
+	struct d_tm_node_t *vom_bloom_fp;  /* Bloom filter false positives */
+};
+
+void vos_oi_metrics_init(struct vos_oi_metrics *vo_metrics, const char *path, int tgt_id);
+
 struct vos_pool_metrics {
 	void			*vp_vea_metrics;
 	struct vos_agg_metrics	 vp_agg_metrics;
@@ -251,6 +262,7 @@ struct vos_pool_metrics {
 	struct vos_space_metrics vp_space_metrics;
 	struct vos_chkpt_metrics vp_chkpt_metrics;
 	struct vos_wal_metrics	 vp_wal_metrics;
+	struct vos_oi_metrics	 vp_oi_metrics;
 	/* TODO: add more metrics for VOS */
 };
 
@@ -376,11 +388,23 @@ struct vos_container {
 	 * * transaction with older epoch must have been committed.
 	 */
 	daos_epoch_t		vc_solo_dtx_epoch;
+	/* In-memory bloom filter for negative OI lookup, see vos_oi_find() */
+	uint64_t		*vc_oi_bloom;
+	/* Number of bits in vc_oi_bloom, power of 2 */
+	uint64_t		vc_oi_bloom_bits;
+	/* Number of OIDs added to vc_oi_bloom */
+	uint64_t		vc_oi_bloom_nr;
+	/* OI lookups which walked the tree, were answered by vc_oi_bloom or were false positives */
+	uint64_t		vc_oi_tree_lookups;
+	uint64_t		vc_oi_bloom_neg;
+	uint64_t		vc_oi_bloom_fp;
 
 	/* Various flags */
 	unsigned int		vc_in_aggregation:1,
 				vc_in_discard:1,
-				vc_cmt_dtx_indexed:1;
+				vc_cmt_dtx_indexed:1,
+				vc_oi_bloom_ready:1,
+				vc_oi_bloom_off:1;
 	unsigned int		vc_obj_discard_count;
 	unsigned int		vc_open_count;
 };
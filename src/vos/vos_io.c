@@ -1768,6 +1768,41 @@ akey_update_single(daos_handle_t toh, uint32_t pm_ver, daos_size_t rsize,
 	return rc;
 }
 
+/** Store adjacent recxs of the same update as a single extent, enabled by default */
+bool vos_recx_combine = true;
+
+/*
+ * Return how many recxs starting from @idx can be stored as one evtree extent.
+ * They share the epoch of the update, so combining index-contiguous recxs does
+ * not change what any reader can observe, but saves evtree records and reduces
+ * the work for aggregation. Per-recx checksums, dedup, EC and removal keep the
+ * one extent per recx layout.
+ */
+static int
+iod_recx_run(struct vos_io_context *ioc, daos_iod_t *iod, struct dcs_csum_info *iod_csums,
+	     int idx)
+{
+	daos_recx_t	*prev;
+	daos_recx_t	*cur;
+	int		 i;
+
+	if (!vos_recx_combine || iod->iod_type != DAOS_IOD_ARRAY || iod_csums != NULL ||
+	    ioc->ic_dedup || ioc->ic_remove || ioc->ic_ec || iod->iod_size == 0)
+		return 1;
+
+	prev = &iod->iod_recxs[idx];
+	if (prev->rx_nr == 0)
+		return 1;
+
+	for (i = idx + 1; i < iod->iod_nr; i++, prev = cur) {
+		cur = &iod->iod_recxs[i];
+		if (cur->rx_nr == 0 || prev->rx_idx + prev->rx_nr != cur->rx_idx)
+			break;
+	}
+
+	return i - idx;
+}
+
 /**
  * Update a record extent.
  * See comment of vos_recx_fetch for explanation of @off_p.
@@ -1887,8 +1922,11 @@ update_value(struct vos_io_context *ioc, daos_iod_t *iod, struct dcs_csum_info *
 {
 	struct dcs_csum_info *recx_csum;
 	struct vos_object    *obj = ioc->ic_obj;
+	daos_recx_t           recx;
 	int                   rc  = 0;
+	int                   nr;
 	int                   i;
+	int                   j;
 
 	if (iod->iod_type == DAOS_IOD_SINGLE) {
 		uint64_t gsize = iod->iod_size;
@@ -1904,9 +1942,10 @@ update_value(struct vos_io_context *ioc, daos_iod_t *iod, struct dcs_csum_info *
 		return rc;
 	}
 
-	for (i = 0; i < iod->iod_nr; i++) {
+	for (i = 0; i < iod->iod_nr; i += nr) {
 		umem_off_t umoff = iod_update_umoff(ioc);
 
+		nr = 1;
 		if (iod->iod_recxs[i].rx_nr == 0) {
 			D_ASSERT(UMOFF_IS_NULL(umoff));
 			D_DEBUG(DB_IO, "Skip empty write IOD at %d: idx %lu, nr %lu\n", i,
@@ -1915,9 +1954,18 @@ update_value(struct vos_io_context *ioc, daos_iod_t *iod, struct dcs_csum_info *
 			continue;
 		}
 
+		/* The head recx owns the space, the others are holes, see akey_update_begin */
+		recx = iod->iod_recxs[i];
+		nr = iod_recx_run(ioc, iod, iod_csums, i);
+		for (j = 1; j < nr; j++) {
+			iod_update_umoff(ioc);
+			recx.rx_nr += iod->iod_recxs[i + j].rx_nr;
+		}
+
 		recx_csum = recx_csum_at(iod_csums, i, iod);
-		rc = akey_update_recx(toh, pm_ver, &iod->iod_recxs[i], recx_csum, iod->iod_size,
-				      ioc, minor_epc);
+		rc = akey_update_recx(toh, pm_ver, &recx, recx_csum, iod->iod_size, ioc, minor_epc);
+		for (j = 1; j < nr; j++)
+			iod_update_biov(ioc);
 		if (rc == 1) {
 			ioc->ic_agg_needed = 1;
 			rc                 = 0;
@@ -2384,7 +2432,7 @@ akey_update_begin(struct vos_io_context *ioc)
 	struct dcs_csum_info	*iod_csums = vos_csum_at(ioc->ic_iod_csums, ioc->ic_sgl_at);
 	struct dcs_csum_info	*recx_csum;
 	daos_iod_t *iod = &ioc->ic_iods[ioc->ic_sgl_at];
-	int i, rc;
+	int i, j, nr, rc;
 
 	if (iod->iod_type == DAOS_IOD_SINGLE && iod->iod_nr != 1) {
 		D_ERROR("Invalid sv iod_nr=%d\n", iod->iod_nr);
@@ -2392,7 +2440,7 @@ akey_update_begin(struct vos_io_context *ioc)
 	}
 
 	//Yuanguo: for each record extent (single-value-akey看作1个record extent)
-	for (i = 0; i < iod->iod_nr; i++) {
+	for (i = 0; i < iod->iod_nr; i += nr) {
 		daos_size_t size;
 		uint16_t media;
 
@@ -2401,6 +2449,11 @@ akey_update_begin(struct vos_io_context *ioc)
 		size = (iod->iod_type == DAOS_IOD_SINGLE) ? iod->iod_size :
 				iod->iod_recxs[i].rx_nr * iod->iod_size;
 
+		/* Adjacent recxs share one reservation, see iod_recx_run */
+		nr = iod_recx_run(ioc, iod, iod_csums, i);
+		for (j = 1; j < nr; j++)
+			size += iod->iod_recxs[i + j].rx_nr * iod->iod_size;
+
 		//Yuanguo: 小于(严格小于，不是小于等于)pool的vp_data_thresh的record extent写在SCM(PMEM/BMEM)上；
 		if (vos_io_scm(vos_cont2pool(ioc->ic_cont), iod->iod_type, size, VOS_IOS_GENERIC))
 			media = DAOS_MEDIA_SCM;
@@ -2417,6 +2470,9 @@ akey_update_begin(struct vos_io_context *ioc)
 						 iod->iod_size);
 			rc = vos_reserve_recx(ioc, media, size, recx_csum,
 					      csum_len);
+			/* Keep one (hole) iov per recx, data goes to the head one */
+			for (j = 1; j < nr && rc == 0; j++)
+				rc = vos_reserve_recx(ioc, media, 0, NULL, 0);
 		}
 		if (rc)
 			return rc;
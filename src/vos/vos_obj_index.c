@@ -40,6 +40,154 @@ struct vos_oi_iter {
 	uint32_t		 oit_flags;
 };
 
+/** Bloom filter for negative OI lookup, disabled by default */
+bool vos_oi_bloom_enabled;
+
+#define OI_BLOOM_BITS_MIN	(1ULL << 16)	/* 8KiB */
+#define OI_BLOOM_BITS_MAX	(1ULL << 30)	/* 128MiB */
+#define OI_BLOOM_BITS_PER_OID	16
+#define OI_BLOOM_HASHES		8
+#define OI_BLOOM_SEED		0x626c6f6fU
+
+static inline void
+oi_bloom_set(struct vos_container *cont, daos_unit_oid_t *oid)
+{
+	uint64_t	h1;
+	uint64_t	h2;
+	uint64_t	bit;
+	int		i;
+
+	h1 = d_hash_murmur64((unsigned char *)oid, sizeof(*oid), OI_BLOOM_SEED);
+	h2 = d_hash_mix64(h1) | 1;
+	for (i = 0; i < OI_BLOOM_HASHES; i++) {
+		bit = (h1 + i * h2) & (cont->vc_oi_bloom_bits - 1);
+		cont->vc_oi_bloom[bit >> 6] |= 1ULL << (bit & 63);
+	}
+}
+
+static inline bool
+oi_bloom_test(struct vos_container *cont, daos_unit_oid_t *oid)
+{
+	uint64_t	h1;
+	uint64_t	h2;
+	uint64_t	bit;
+	int		i;
+
+	h1 = d_hash_murmur64((unsigned char *)oid, sizeof(*oid), OI_BLOOM_SEED);
+	h2 = d_hash_mix64(h1) | 1;
+	for (i = 0; i < OI_BLOOM_HASHES; i++) {
+		bit = (h1 + i * h2) & (cont->vc_oi_bloom_bits - 1);
+		if ((cont->vc_oi_bloom[bit >> 6] & (1ULL << (bit & 63))) == 0)
+			return false;
+	}
+	return true;
+}
+
+/** Called for each new OI entry, even if the transaction is aborted later. */
+static void
+oi_bloom_add(struct vos_container *cont, daos_unit_oid_t *oid)
+{
+	if (!cont->vc_oi_bloom_ready)
+		return;
+
+	/* Too full to be useful, rebuild it with more bits on next lookup. */
+	if (++cont->vc_oi_bloom_nr * OI_BLOOM_BITS_PER_OID > cont->vc_oi_bloom_bits) {
+		cont->vc_oi_bloom_ready = 0;
+		return;
+	}
+	oi_bloom_set(cont, oid);
+}
+
+static int
+oi_bloom_build_cb(daos_handle_t ih, d_iov_t *key, d_iov_t *val, void *arg)
+{
+	struct vos_container	*cont = arg;
+	struct vos_obj_df	*obj = val->iov_buf;
+
+	oi_bloom_set(cont, &obj->vo_id);
+	cont->vc_oi_bloom_nr++;
+	return 0;
+}
+
+/**
+ * (Re)build the bloom filter from the OI tree. The filter is sized for twice
+ * the current number of objects, so that it does not need to be rebuilt soon.
+ */
+static int
+oi_bloom_build(struct vos_container *cont)
+{
+	struct btr_attr	 attr;
+	uint64_t	 nr;
+	uint64_t	 bits;
+	int		 rc;
+
+	rc = dbtree_query(cont->vc_btr_hdl, &attr, NULL);
+	if (rc != 0)
+		return rc;
+
+	nr = max((uint64_t)attr.ba_count, cont->vc_oi_bloom_nr);
+	bits = OI_BLOOM_BITS_MIN;
+	while (bits < OI_BLOOM_BITS_MAX && bits < nr * 2 * OI_BLOOM_BITS_PER_OID)
+		bits <<= 1;
+
+	if (bits != cont->vc_oi_bloom_bits) {
+		D_FREE(cont->vc_oi_bloom);
+		cont->vc_oi_bloom_bits = 0;
+		D_ALLOC_ARRAY(cont->vc_oi_bloom, bits >> 6);
+		if (cont->vc_oi_bloom == NULL)
+			return -DER_NOMEM;
+		cont->vc_oi_bloom_bits = bits;
+	} else {
+		memset(cont->vc_oi_bloom, 0, bits >> 3);
+	}
+
+	cont->vc_oi_bloom_nr = 0;
+	rc = dbtree_iterate(cont->vc_btr_hdl, DAOS_INTENT_DEFAULT, false, oi_bloom_build_cb,
+			    cont);
+	if (rc != 0)
+		return rc;
+
+	if (cont->vc_oi_bloom_nr * OI_BLOOM_BITS_PER_OID > bits) {
+		D_INFO("Too many objects (" DF_U64 ") for OI bloom filter of " DF_U64 " bits\n",
+		       cont->vc_oi_bloom_nr, bits);
+		D_FREE(cont->vc_oi_bloom);
+		cont->vc_oi_bloom_bits = 0;
+		cont->vc_oi_bloom_off = 1;
+		return 0;
+	}
+
+	D_DEBUG(DB_TRACE, "Built OI bloom filter, bits " DF_U64 ", objects " DF_U64 "\n", bits,
+		cont->vc_oi_bloom_nr);
+	cont->vc_oi_bloom_ready = 1;
+	return 0;
+}
+
+/**
+ * Return true if \a oid is definitely not in the OI table. The filter is built
+ * lazily on first lookup after the container is opened.
+ */
+static bool
+oi_bloom_negative(struct vos_container *cont, daos_unit_oid_t *oid)
+{
+	int	rc;
+
+	if (!vos_oi_bloom_enabled || cont->vc_oi_bloom_off)
+		return false;
+
+	if (!cont->vc_oi_bloom_ready) {
+		rc = oi_bloom_build(cont);
+		if (rc != 0) {
+			D_WARN("Failed to build OI bloom filter: " DF_RC "\n", DP_RC(rc));
+			cont->vc_oi_bloom_off = 1;
+			return false;
+		}
+		if (!cont->vc_oi_bloom_ready)
+			return false;
+	}
+
+	return !oi_bloom_test(cont, oid);
+}
+
 static int
 oi_hkey_size(void)
 {
@@ -111,6 +259,7 @@ oi_rec_alloc(struct btr_instance *tins, d_iov_t *key_iov,
 
 	d_iov_set(val_iov, obj, sizeof(struct vos_obj_df));
 	rec->rec_off = obj_off;
+	oi_bloom_add(cont, key);
 
 	/* For new created object, commit it synchronously to reduce
 	 * potential conflict with subsequent modifications against
@@ -218,13 +367,30 @@ int
 vos_oi_find(struct vos_container *cont, daos_unit_oid_t oid,
 	    struct vos_obj_df **obj_p, struct vos_ts_set *ts_set)
 {
+	struct vos_oi_metrics	*vom = NULL;
 	struct ilog_df		*ilog = NULL;
 	d_iov_t			 key_iov;
 	d_iov_t			 val_iov;
+	bool			 bloom;
 	int			 rc;
 	int			 tmprc;
 
 	*obj_p = NULL;
+	if (cont->vc_pool->vp_metrics != NULL) {
+		vom = &cont->vc_pool->vp_metrics->vp_oi_metrics;
+		d_tm_inc_counter(vom->vom_lookups, 1);
+	}
+
+	if (oi_bloom_negative(cont, &oid)) {
+		cont->vc_oi_bloom_neg++;
+		if (vom != NULL)
+			d_tm_inc_counter(vom->vom_bloom_neg, 1);
+		rc = -DER_NONEXIST;
+		goto out;
+	}
+	bloom = cont->vc_oi_bloom_ready;
+	cont->vc_oi_tree_lookups++;
+
 	d_iov_set(&key_iov, &oid, sizeof(oid));
 	d_iov_set(&val_iov, NULL, 0);
 
@@ -236,8 +402,13 @@ vos_oi_find(struct vos_container *cont, daos_unit_oid_t oid,
 		D_ASSERT(daos_unit_obj_id_equal(obj->vo_id, oid));
 		*obj_p = obj;
 		ilog = &obj->vo_ilog;
+	} else if (rc == -DER_NONEXIST && bloom) {
+		cont->vc_oi_bloom_fp++;
+		if (vom != NULL)
+			d_tm_inc_counter(vom->vom_bloom_fp, 1);
 	}
 
+out:
 	tmprc = vos_ilog_ts_add(ts_set, ilog, &oid, sizeof(oid));
 
 	D_ASSERT(tmprc == 0); /* Non-zero return for akey only */
@@ -1013,3 +1184,29 @@ vos_obj_tab_register()
 		D_ERROR("dbtree create failed\n");
 	return rc;
 }
+
+#define VOS_OI_DIR "vos_oi"
+
+void
+vos_oi_metrics_init(struct vos_oi_metrics *vom, const char *path, int tgt_id)
+{
+	int rc;
+
+	/* OI lookups */
+	rc = d_tm_add_metric(&vom->vom_lookups, D_TM_COUNTER, "OI lookups", NULL,
+			     "%s/%s/lookups/tgt_%u", path, VOS_OI_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'lookups' telemetry: " DF_RC "\n", DP_RC(rc));
+
+	/* OI lookups answered by bloom filter */
+	rc = d_tm_add_metric(&vom->vom_bloom_neg, D_TM_COUNTER, "OI bloom filter negatives", NULL,
+			     "%s/%s/bloom_neg/tgt_%u", path, VOS_OI_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'bloom_neg' telemetry: " DF_RC "\n", DP_RC(rc));
+
+	/* OI bloom filter false positives */
+	rc = d_tm_add_metric(&vom->vom_bloom_fp, D_TM_COUNTER, "OI bloom filter false positives",
+			     NULL, "%s/%s/bloom_fp/tgt_%u", path, VOS_OI_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'bloom_fp' telemetry: " DF_RC "\n", DP_RC(rc));
+}